@@ -9,6 +9,56 @@ This program calculates CGPA across multiple semesters, allowing for saving/load
 #include <stdexcept>      // For custom exceptions in advanced error handling
 #include <memory>       // For smart pointers if needed, though not heavily used here
 #include <algorithm>  // For std::for_each or other algorithms11
+#include <thread>     // For spreading cohort-wide work across cores
+#include <cstdint>    // Fixed-width ints for the fixed-point ranking keys
+#include <cmath>      // std::llround when turning CGPAs into fixed-point
+#include <iterator>   // std::back_inserter for merging re-ranked students
+#include <mutex>      // Guards the merge step when parallel workers hand back partial results
+#include <queue>      // Bounded heaps for top-k queries
+#include <string>
+#include <unordered_map> // Hash tables for group-by aggregation
+#include <deque>      // Per-worker task deques in the scheduler
+#include <functional> // std::function for type-erased tasks
+#include <atomic>
+#include <utility>    // std::exchange
+#include <initializer_list>
+#include <condition_variable>
+#include <shared_mutex> // Reader/writer locks for registry shards
+#include <chrono>     // Timing for instrumentation and the load generator
+#include <array>
+#include <cstdio>     // std::rename for swapping in a fresh metrics file
+#include <cstdlib>    // std::malloc/std::free behind the allocation-tracking operator new
+#include <new>
+#include <cstring>    // std::memcpy for the binary wire format
+#include <charconv>   // std::from_chars / std::to_chars for fast input and JSON output
+#include <cctype>
+#include <string_view>
+#if __cplusplus >= 202002L && __has_include(<coroutine>)
+#define CGPA_HAVE_COROUTINES 1
+#include <coroutine>  // Awaitable load/save/compute when built as C++20
+#include <optional>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#define CGPA_HAVE_UNIX_SOCKETS 1
+#include <sys/socket.h>  // Server mode talks over a Unix domain socket
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#ifdef __linux__
+#define CGPA_HAVE_EPOLL 1
+#include <sys/epoll.h>   // Event-driven TCP front-end
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <cerrno>
+#if __has_include(<linux/io_uring.h>)
+#define CGPA_HAVE_IO_URING 1
+#include <linux/io_uring.h>  // Batched opens/reads for the bulk loader (raw syscalls, no liburing needed)
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#endif
+#endif
 
 // Using namespace std is avoided in advanced code to prevent name collisions.
 // Instead, we'll use std:: prefixes or selective using declarations.
@@ -21,6 +71,11 @@ class InvalidCreditException : public std::runtime_error {
 public:
     InvalidCreditException(const std::string& msg) : std::runtime_error(msg) {}
 };
+// Thrown when stdin runs out while the menu is waiting for an answer, so main can tell "done" apart from real errors.
+class EndOfInputException : public std::runtime_error {
+public:
+    EndOfInputException() : std::runtime_error("Input ended.") {}
+};
 /*
  * Alright, so this is an upgraded CGPA Calculator. I took the original and made it way more solid using modern C++ tricks.
  * Think RAII for handling resources automatically, exceptions to catch screw-ups without crashing, and keeping things
@@ -32,10 +87,585 @@ public:
  * Key points covered (as per your reminder):
  * - Take input for the number of courses taken by the student (done in main, case 1, with validation).
  * - For each course, input the grade and the credit hours (handled in the loop with getValidatedInput).
+ *   Or paste whole semesters at once as grade:credit pairs (pasteSemesters, menu option 8).
  * - Calculate the total credits and total grade points (grade × credit hours) (this happens in calculateGPA and calculateCGPA).
  * - Compute the GPA for the semester and then the overall CGPA (Semester::calculateGPA for per-semester, Student::calculateCGPA for overall).
  * - Display individual course grades and the final CGPA to the user (via displayCourses and displayAll).
  */
+/*
+ * Instrumentation
+ * Scoped timers around the hot paths (loadFromFile, calculateCGPA, saveToFile) feeding per-thread latency
+ * histograms. Build with -DCGPA_INSTRUMENT to turn it on; without it CGPA_TIME_SCOPE expands to nothing, so the
+ * normal build pays exactly zero for it.
+ * The histograms are HDR-style: exact below 32 ns, then 16 sub-buckets per power of two, so any recorded
+ * latency is within ~6% and the whole range up to hours fits in under a thousand counters.
+ * Each thread only ever writes its own histograms (plain relaxed load + store, no locked instructions); a dump
+ * reads everyone's and adds them up. Threads that exit fold their counts into a "retired" total first.
+ */
+enum class Probe : size_t { LoadFromFile, CalculateCGPA, SaveToFile, Count };
+constexpr size_t probeCount = static_cast<size_t>(Probe::Count);
+inline const char* probeName(size_t probe) noexcept {
+    static const char* const names[probeCount] = {"loadFromFile", "calculateCGPA", "saveToFile"};
+    return names[probe];
+}
+// Event counters for the metrics export. Unlike the timers these are always on – bumping one is a thread-local
+// store, and the busy paths (like parsing) add up locally and report once per call anyway.
+enum class Counter : size_t { SemestersAdded, CoursesParsed, Saves, LoadErrors, Count };
+constexpr size_t counterCount = static_cast<size_t>(Counter::Count);
+class LatencyHistogram {
+public:
+    static constexpr unsigned subBits = 4;
+    static constexpr size_t bucketCount = (64 - subBits - 1) * (size_t{1} << subBits) + (size_t{2} << subBits);
+    static size_t bucketFor(uint64_t ns) noexcept {
+        if (ns < (uint64_t{2} << subBits)) {
+            return static_cast<size_t>(ns);
+        }
+        unsigned msb = 63;
+        while (!(ns >> msb)) {
+            --msb;
+        }
+        const unsigned shift = msb - subBits;
+        return (size_t{shift} << subBits) + ((ns >> shift) & ((uint64_t{1} << subBits) - 1)) + (size_t{1} << subBits);
+    }
+    // Smallest latency that lands in the bucket – what the reports print.
+    static uint64_t bucketFloor(size_t bucket) noexcept {
+        if (bucket < (size_t{2} << subBits)) {
+            return bucket;
+        }
+        const size_t rel = bucket - (size_t{1} << subBits);
+        return ((uint64_t{1} << subBits) + (rel & ((size_t{1} << subBits) - 1))) << (rel >> subBits);
+    }
+    // Owner thread only.
+    void record(uint64_t ns) noexcept {
+        auto& c = counts[bucketFor(ns)];
+        c.store(c.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        totalNs.store(totalNs.load(std::memory_order_relaxed) + ns, std::memory_order_relaxed);
+    }
+    uint64_t sumNs() const noexcept { return totalNs.load(std::memory_order_relaxed); }
+    // Safe from any thread.
+    void addTo(std::vector<uint64_t>& totals) const noexcept {
+        for (size_t i = 0; i < bucketCount; ++i) {
+            totals[i] += counts[i].load(std::memory_order_relaxed);
+        }
+    }
+private:
+    std::array<std::atomic<uint64_t>, bucketCount> counts{};
+    std::atomic<uint64_t> totalNs{0};  // Summed latency, for the metrics summary's _sum line.
+};
+class Instrumentation {
+private:
+    struct ThreadSlot {
+        std::array<LatencyHistogram, probeCount> probes;
+        std::array<std::atomic<uint64_t>, counterCount> counters{};
+    };
+    std::mutex lock;
+    std::vector<ThreadSlot*> live;
+    std::vector<std::vector<uint64_t>> retired =
+        std::vector<std::vector<uint64_t>>(probeCount, std::vector<uint64_t>(LatencyHistogram::bucketCount, 0));
+    std::array<uint64_t, probeCount> retiredSums{};
+    std::array<uint64_t, counterCount> retiredCounters{};
+
+    // Owns the calling thread's slot; registers on first use and hands the counts over when the thread ends.
+    struct SlotHandle {
+        Instrumentation& owner;
+        ThreadSlot slot;
+        explicit SlotHandle(Instrumentation& o) : owner(o) {
+            std::lock_guard<std::mutex> guard(owner.lock);
+            owner.live.push_back(&slot);
+        }
+        ~SlotHandle() {
+            std::lock_guard<std::mutex> guard(owner.lock);
+            for (size_t p = 0; p < probeCount; ++p) {
+                slot.probes[p].addTo(owner.retired[p]);
+                owner.retiredSums[p] += slot.probes[p].sumNs();
+            }
+            for (size_t c = 0; c < counterCount; ++c) {
+                owner.retiredCounters[c] += slot.counters[c].load(std::memory_order_relaxed);
+            }
+            owner.live.erase(std::remove(owner.live.begin(), owner.live.end(), &slot), owner.live.end());
+        }
+    };
+    ThreadSlot& localSlot() {
+        thread_local SlotHandle handle(*this);
+        return handle.slot;
+    }
+public:
+    // Deliberately never destroyed: pool threads can still be exiting (and handing in their counts) during
+    // static teardown, and they need this to still be around.
+    static Instrumentation& instance() {
+        static Instrumentation* inst = new Instrumentation();
+        return *inst;
+    }
+    void record(Probe probe, uint64_t ns) noexcept {
+        localSlot().probes[static_cast<size_t>(probe)].record(ns);
+    }
+    void count(Counter counter, uint64_t n = 1) noexcept {
+        auto& c = localSlot().counters[static_cast<size_t>(counter)];
+        c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+    // Lazily adds up one counter over every thread – only metrics exports pay for this.
+    uint64_t counterTotal(Counter counter) {
+        const size_t c = static_cast<size_t>(counter);
+        std::lock_guard<std::mutex> guard(lock);
+        uint64_t total = retiredCounters[c];
+        for (const ThreadSlot* slot : live) {
+            total += slot->counters[c].load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+    uint64_t latencySumNs(Probe probe) {
+        const size_t p = static_cast<size_t>(probe);
+        std::lock_guard<std::mutex> guard(lock);
+        uint64_t total = retiredSums[p];
+        for (const ThreadSlot* slot : live) {
+            total += slot->probes[p].sumNs();
+        }
+        return total;
+    }
+    // Merged bucket counts for one probe across every thread, past and present.
+    std::vector<uint64_t> merged(Probe probe) {
+        const size_t p = static_cast<size_t>(probe);
+        std::lock_guard<std::mutex> guard(lock);
+        std::vector<uint64_t> totals = retired[p];
+        for (const ThreadSlot* slot : live) {
+            slot->probes[p].addTo(totals);
+        }
+        return totals;
+    }
+};
+#ifdef CGPA_INSTRUMENT
+class ScopedTimer {
+private:
+    Probe probe;
+    std::chrono::steady_clock::time_point start;
+public:
+    explicit ScopedTimer(Probe p) noexcept : probe(p), start(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        Instrumentation::instance().record(probe, static_cast<uint64_t>(ns.count()));
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+};
+#define CGPA_TIME_SCOPE(probe) ScopedTimer cgpaScopedTimer(probe)
+#else
+#define CGPA_TIME_SCOPE(probe) ((void)0)
+#endif
+/*
+ * Function: bucketPercentile
+ * q-th percentile (0–1) of a merged latency histogram, as the floor of the bucket it lands in. 0 when empty.
+ */
+uint64_t bucketPercentile(const std::vector<uint64_t>& buckets, double q) {
+    uint64_t total = 0;
+    for (uint64_t c : buckets) {
+        total += c;
+    }
+    if (total == 0) {
+        return 0;
+    }
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < buckets.size(); ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return LatencyHistogram::bucketFloor(i);
+        }
+    }
+    return 0;
+}
+/*
+ * Function: dumpInstrumentation
+ * Prints count / p50 / p90 / p99 / max per probe. Human mode is a little table for the menu; machine mode is one
+ * "key=value" line per probe for scripts (batch mode uses it).
+ */
+void dumpInstrumentation(std::ostream& out, bool machineReadable) {
+#ifndef CGPA_INSTRUMENT
+    if (!machineReadable) {
+        out << "Instrumentation is off – rebuild with -DCGPA_INSTRUMENT to collect timings." << std::endl;
+    }
+#else
+    for (size_t p = 0; p < probeCount; ++p) {
+        const std::vector<uint64_t> buckets = Instrumentation::instance().merged(static_cast<Probe>(p));
+        uint64_t total = 0;
+        for (uint64_t c : buckets) {
+            total += c;
+        }
+        const uint64_t p50 = bucketPercentile(buckets, 0.5), p90 = bucketPercentile(buckets, 0.9);
+        const uint64_t p99 = bucketPercentile(buckets, 0.99), pmax = bucketPercentile(buckets, 1.0);
+        if (machineReadable) {
+            out << "probe=" << probeName(p) << " count=" << total << " p50_ns=" << p50 << " p90_ns=" << p90
+                << " p99_ns=" << p99 << " max_ns=" << pmax << '\n';
+        } else {
+            out << std::left << std::setw(14) << probeName(p) << std::right << " count " << std::setw(8) << total
+                << " | p50 " << p50 << " ns | p90 " << p90 << " ns | p99 " << p99 << " ns | max " << pmax << " ns"
+                << std::endl;
+        }
+    }
+    out.flush();
+#endif
+}
+/*
+ * Allocation tracking
+ * Build with -DCGPA_TRACK_ALLOCS to replace the global operator new/delete with versions that count every
+ * allocation (and its bytes) against whatever subsystem tag the current thread is working under. Set the tag with
+ * CGPA_ALLOC_SCOPE(AllocTag::X) – it's a no-op in normal builds. The benchmark and batch modes print the counts
+ * per operation, which is what you want when chasing down vector regrowth and other needless allocations.
+ * Counters are relaxed atomics; allocation is already slow enough that the extra increment doesn't show.
+ */
+enum class AllocTag : size_t { Other, Ingest, Persistence, Compute, Count };
+constexpr size_t allocTagCount = static_cast<size_t>(AllocTag::Count);
+inline const char* allocTagName(size_t tag) noexcept {
+    static const char* const names[allocTagCount] = {"other", "ingest", "persistence", "compute"};
+    return names[tag];
+}
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t bytes = 0;
+};
+class AllocationTracker {
+private:
+    static inline std::atomic<uint64_t> counts[allocTagCount] = {};
+    static inline std::atomic<uint64_t> byteCounts[allocTagCount] = {};
+    static inline thread_local AllocTag currentTag = AllocTag::Other;
+public:
+    static void note(size_t bytes) noexcept {
+        const size_t tag = static_cast<size_t>(currentTag);
+        counts[tag].fetch_add(1, std::memory_order_relaxed);
+        byteCounts[tag].fetch_add(bytes, std::memory_order_relaxed);
+    }
+    static AllocTag swapTag(AllocTag tag) noexcept { return std::exchange(currentTag, tag); }
+    static AllocStats tagTotals(AllocTag tag) noexcept {
+        const size_t t = static_cast<size_t>(tag);
+        return AllocStats{counts[t].load(std::memory_order_relaxed), byteCounts[t].load(std::memory_order_relaxed)};
+    }
+    // Everything across all tags – take one before and one after an operation and subtract.
+    static AllocStats totals() noexcept {
+        AllocStats all;
+        for (size_t t = 0; t < allocTagCount; ++t) {
+            const AllocStats one = tagTotals(static_cast<AllocTag>(t));
+            all.allocations += one.allocations;
+            all.bytes += one.bytes;
+        }
+        return all;
+    }
+};
+#ifdef CGPA_TRACK_ALLOCS
+// Restores the previous tag on the way out, so nested scopes behave.
+class AllocScope {
+private:
+    AllocTag previous;
+public:
+    explicit AllocScope(AllocTag tag) noexcept : previous(AllocationTracker::swapTag(tag)) {}
+    ~AllocScope() { AllocationTracker::swapTag(previous); }
+    AllocScope(const AllocScope&) = delete;
+    AllocScope& operator=(const AllocScope&) = delete;
+};
+#define CGPA_ALLOC_SCOPE(tag) AllocScope cgpaAllocScope(tag)
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr) {
+        throw std::bad_alloc();
+    }
+    AllocationTracker::note(size);
+    return p;
+}
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p != nullptr) {
+        AllocationTracker::note(size);
+    }
+    return p;
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { return ::operator new(size, tag); }
+// GCC sees malloc/free through these once they inline into std containers and flags a "mismatch" – they
+// really are a matched pair here.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#else
+#define CGPA_ALLOC_SCOPE(tag) ((void)0)
+#endif
+/*
+ * Function: reportAllocations
+ * One "op=<label> allocs=<n> bytes=<n>" line for whatever got allocated between two AllocationTracker::totals()
+ * snapshots. Prints nothing unless tracking is compiled in, so callers can sprinkle it freely.
+ */
+void reportAllocations(std::ostream& out, const std::string& label, const AllocStats& before, const AllocStats& after) {
+#ifdef CGPA_TRACK_ALLOCS
+    out << "op=" << label << " allocs=" << after.allocations - before.allocations
+        << " bytes=" << after.bytes - before.bytes << '\n';
+#else
+    (void)out, (void)label, (void)before, (void)after;
+#endif
+}
+// Per-tag running totals, printed at the end of a batch or benchmark run.
+void reportAllocationTags(std::ostream& out) {
+#ifdef CGPA_TRACK_ALLOCS
+    for (size_t t = 0; t < allocTagCount; ++t) {
+        const AllocStats stats = AllocationTracker::tagTotals(static_cast<AllocTag>(t));
+        out << "alloc_tag=" << allocTagName(t) << " allocs=" << stats.allocations << " bytes=" << stats.bytes << '\n';
+    }
+    out.flush();
+#else
+    (void)out;
+#endif
+}
+/*
+ * Function: writeMetrics
+ * Prometheus text exposition of the counters, plus latency summaries when the timers are compiled in.
+ * Scrape it however suits – writeMetricsFile for a node-exporter style textfile, or print it from the menu.
+ */
+void writeMetrics(std::ostream& out) {
+    Instrumentation& inst = Instrumentation::instance();
+    struct CounterInfo {
+        Counter counter;
+        const char* name;
+        const char* help;
+    };
+    static const CounterInfo counters[] = {
+        {Counter::SemestersAdded, "cgpa_semesters_added_total", "Semesters added to a student."},
+        {Counter::CoursesParsed, "cgpa_courses_parsed_total", "Courses read from saved data."},
+        {Counter::Saves, "cgpa_saves_total", "Successful saves to file."},
+        {Counter::LoadErrors, "cgpa_load_errors_total", "Loads rejected as corrupt data."},
+    };
+    for (const auto& info : counters) {
+        out << "# HELP " << info.name << ' ' << info.help << '\n'
+            << "# TYPE " << info.name << " counter\n"
+            << info.name << ' ' << inst.counterTotal(info.counter) << '\n';
+    }
+#ifdef CGPA_INSTRUMENT
+    out << "# HELP cgpa_latency_seconds Latency of the instrumented operations.\n"
+        << "# TYPE cgpa_latency_seconds summary\n";
+    for (size_t p = 0; p < probeCount; ++p) {
+        const std::vector<uint64_t> buckets = inst.merged(static_cast<Probe>(p));
+        uint64_t total = 0;
+        for (uint64_t c : buckets) {
+            total += c;
+        }
+        const std::string label = std::string("{op=\"") + probeName(p) + "\"";
+        for (double q : {0.5, 0.9, 0.99}) {
+            out << "cgpa_latency_seconds" << label << ",quantile=\"" << q << "\"} "
+                << static_cast<double>(bucketPercentile(buckets, q)) * 1e-9 << '\n';
+        }
+        out << "cgpa_latency_seconds_sum" << label << "} "
+            << static_cast<double>(inst.latencySumNs(static_cast<Probe>(p))) * 1e-9 << '\n'
+            << "cgpa_latency_seconds_count" << label << "} " << total << '\n';
+    }
+#endif
+    out.flush();
+}
+/*
+ * Function: replaceFile
+ * Renames a finished temp file over the target. Windows won't rename onto an existing file, so if the first try
+ * fails the old target is removed and it tries once more. Returns false if that didn't work either.
+ */
+bool replaceFile(const std::string& temp, const std::string& path) {
+    if (std::rename(temp.c_str(), path.c_str()) != 0) {
+        std::remove(path.c_str());
+        return std::rename(temp.c_str(), path.c_str()) == 0;
+    }
+    return true;
+}
+/*
+ * Function: writeMetricsFile
+ * Writes the exposition to a temp file and renames it over the target, so a scraper never sees half a file.
+ * Returns false if the file couldn't be written.
+ */
+bool writeMetricsFile(const std::string& path) {
+    const std::string temp = path + ".tmp";
+    {
+        std::ofstream file(temp);
+        if (!file) {
+            return false;
+        }
+        writeMetrics(file);
+        if (!file) {
+            return false;
+        }
+    }
+    return replaceFile(temp, path);
+}
+/*
+ * Function: startMetricsDumper
+ * For the long-running server modes: refreshes the metrics file every `seconds` on a background thread
+ * for the rest of the process's life.
+ */
+void startMetricsDumper(const std::string& path, unsigned seconds) {
+    std::thread([path, seconds]() {
+        while (true) {
+            writeMetricsFile(path);
+            std::this_thread::sleep_for(std::chrono::seconds(seconds));
+        }
+    }).detach();
+}
+/*
+ * Class: InputTokenizer
+ * Splits input on whitespace and parses numbers with std::from_chars instead of going through iostreams,
+ * which is a lot quicker (and allocation-free) once somebody pipes a big file in.
+ * It either reads a FILE* a line at a time – stdin for the menu and --batch, with a big stdio buffer behind it –
+ * or walks a buffer that's already in memory, like a saved file. A token never straddles two lines, so after
+ * a bad one the rest of the line can be thrown away and parsing carries on with the next line.
+ */
+enum class TokenStatus { Ok, Bad, End };
+
+// True if [first, last) is exactly one T and nothing else.
+template <typename T>
+bool parseNumber(const char* first, const char* last, T& value) {
+    const auto result = std::from_chars(first, last, value);
+    return result.ec == std::errc() && result.ptr == last;
+}
+#if !defined(__cpp_lib_to_chars)
+// Older standard libraries only do integers in from_chars, so doubles fall back to strtod there.
+inline bool parseNumber(const char* first, const char* last, double& value) {
+    const std::string token(first, last);
+    char* stop = nullptr;
+    value = std::strtod(token.c_str(), &stop);
+    return !token.empty() && stop == token.c_str() + token.size();
+}
+#endif
+
+class InputTokenizer {
+public:
+    explicit InputTokenizer(std::FILE* source) : source(source) {}
+    InputTokenizer(const char* data, size_t size) : cur(data), end(data + size) {}
+    InputTokenizer(const InputTokenizer&) = delete;
+    InputTokenizer& operator=(const InputTokenizer&) = delete;
+    // Parses the next token as a T. Bad means it wasn't cleanly a T (it's used up anyway); End means no input left.
+    template <typename T>
+    TokenStatus next(T& value) {
+        if (!skipSpace()) {
+            return TokenStatus::End;
+        }
+        const char* tokenEnd = tokenStop();
+        const bool clean = parseNumber(cur, tokenEnd, value);
+        cur = tokenEnd;
+        return clean ? TokenStatus::Ok : TokenStatus::Bad;
+    }
+    // Same thing for a plain word, like the CGPA2 header tag.
+    TokenStatus nextWord(std::string& word) {
+        if (!skipSpace()) {
+            return TokenStatus::End;
+        }
+        const char* tokenEnd = tokenStop();
+        word.assign(cur, tokenEnd);
+        cur = tokenEnd;
+        return TokenStatus::Ok;
+    }
+    // The next non-space character without using it up, or EOF.
+    int peek() {
+        return skipSpace() ? static_cast<unsigned char>(*cur) : EOF;
+    }
+    // Throws away whatever's left on the current line – the recovery step after a bad token.
+    void discardLine() {
+        while (cur < end && *cur != '\n') {
+            ++cur;
+        }
+    }
+    // Whatever's left of the current line as [first, last), newline not included – maybe nothing. Unlike
+    // nextLine() it never moves on to the next line. The pointers stay good until the next call.
+    void restOfLine(const char*& first, const char*& last) {
+        first = cur;
+        last = cur;
+        while (last < end && *last != '\n') {
+            ++last;
+        }
+        cur = last;
+    }
+    // Hands back a whole line as [first, last), newline not included. If the current line still has something
+    // on it, that's what you get; otherwise it's the next line, even a blank one (so callers can stop on those).
+    // The pointers stay good until the next call. Returns false once input runs out.
+    bool nextLine(const char*& first, const char*& last) {
+        const char* p = cur;
+        while (p < end && *p != '\n' && isSpace(*p)) {
+            ++p;
+        }
+        if (p < end && *p != '\n') {
+            first = p;
+        } else {
+            cur = p < end ? p + 1 : p;
+            if (cur == end && !refill()) {
+                return false;
+            }
+            first = cur;
+        }
+        last = first;
+        while (last < end && *last != '\n') {
+            ++last;
+        }
+        cur = last;
+        return true;
+    }
+
+private:
+    static bool isSpace(char ch) {
+        return std::isspace(static_cast<unsigned char>(ch)) != 0;
+    }
+    const char* tokenStop() const {
+        const char* p = cur;
+        while (p < end && !isSpace(*p)) {
+            ++p;
+        }
+        return p;
+    }
+    bool skipSpace() {
+        while (true) {
+            while (cur < end && isSpace(*cur)) {
+                ++cur;
+            }
+            if (cur < end) {
+                return true;
+            }
+            if (!refill()) {
+                return false;
+            }
+        }
+    }
+    // Pulls the next whole line out of the FILE*. Memory-backed tokenizers have nothing more to give.
+    bool refill() {
+        if (!source) {
+            return false;
+        }
+        line.clear();
+        char chunk[1024];
+        while (std::fgets(chunk, sizeof chunk, source)) {
+            line.append(chunk);
+            if (line.back() == '\n') {
+                break;
+            }
+        }
+        cur = line.data();
+        end = cur + line.size();
+        return !line.empty();
+    }
+
+    std::FILE* source = nullptr;
+    std::string line;
+    const char* cur = nullptr;
+    const char* end = nullptr;
+};
+/*
+ * Function: stdinTokenizer
+ * The one tokenizer everybody shares for stdin. The first call swaps in a 64 KiB stdio buffer, so a piped-in
+ * file gets read in big blocks; typing at a terminal still comes through a line at a time.
+ */
+InputTokenizer& stdinTokenizer() {
+    static char buffer[1 << 16];
+    static const bool buffered = std::setvbuf(stdin, buffer, _IOFBF, sizeof buffer) == 0;
+    static InputTokenizer tokenizer(stdin);
+    (void)buffered;
+    return tokenizer;
+}
 /*
  * Class: Course
  * Basically, this just bundles a course's grade and credits together.
@@ -52,58 +682,340 @@ public:
         // Could add checks here, but I left it flexible for now.
     }
 };
+// The limits a course has to fit, wherever it comes in from (menu, paste, CSV, server, ingestor).
+constexpr double minGrade = 0.0;
+constexpr double maxGrade = 10.0;
+constexpr double minCredit = 0.01;
+constexpr double maxCredit = 100.0;
+constexpr size_t maxCoursesPerSemester = 100;
+/*
+ * Function: validateCourse
+ * Throws InvalidGradeException or InvalidCreditException if a course is outside the limits above.
+ * The tests are written as "in range" rather than "out of range", so NaN fails them too – and an infinite
+ * credit, which would turn the CGPA into NaN for good, is over maxCredit anyway.
+ */
+inline void validateCourse(double grade, double credit) {
+    if (!(grade >= minGrade && grade <= maxGrade)) {
+        throw InvalidGradeException("Grade must be between 0 and 10.");
+    }
+    if (!(credit >= minCredit && credit <= maxCredit)) {
+        throw InvalidCreditException("Credits must be between 0.01 and 100.");
+    }
+}
+/*
+ * Class: SmallVector
+ * A vector that keeps its first N elements inside the object itself and only goes to the heap past that.
+ * Most semesters have 4–8 courses, so with the default inline capacity a typical Semester never allocates at all,
+ * while a 15-course semester just spills to the heap like a normal vector would.
+ * It only does what the course list needs: append, reserve, clear, indexing and iteration. Elements sit in raw,
+ * aligned storage, so T doesn't need a default constructor (Course doesn't have one).
+ */
+template <typename T, size_t N>
+class SmallVector {
+private:
+    static constexpr size_t inlineSlots = N == 0 ? 1 : N;
+    alignas(T) unsigned char inlineStorage[inlineSlots * sizeof(T)];
+    T* items;
+    size_t count = 0;
+    size_t cap = N;
+
+    T* inlineData() noexcept { return reinterpret_cast<T*>(inlineStorage); }
+    bool onHeap() const noexcept { return items != reinterpret_cast<const T*>(inlineStorage); }
+    void destroyAll() noexcept {
+        for (size_t i = 0; i < count; ++i) {
+            items[i].~T();
+        }
+        count = 0;
+    }
+    void releaseHeap() noexcept {
+        if (onHeap()) {
+            ::operator delete(items);
+            items = inlineData();
+            cap = N;
+        }
+    }
+    size_t grownCapacity(size_t wanted) const noexcept { return std::max(wanted, cap * 2); }
+    void grow(size_t wanted) {
+        const size_t newCap = grownCapacity(wanted);
+        adopt(static_cast<T*>(::operator new(newCap * sizeof(T))), newCap);
+    }
+    // Moves everything into a fresh block (already allocated by the caller) and lets the old one go.
+    void adopt(T* fresh, size_t newCap) noexcept {
+        std::uninitialized_move(items, items + count, fresh);
+        const size_t kept = count;
+        destroyAll();
+        releaseHeap();
+        items = fresh;
+        count = kept;
+        cap = newCap;
+    }
+    // Takes other's elements; steals its heap block outright when it has one.
+    void takeFrom(SmallVector& other) noexcept {
+        if (other.onHeap()) {
+            items = other.items;
+            count = other.count;
+            cap = other.cap;
+            other.items = other.inlineData();
+            other.count = 0;
+            other.cap = N;
+        } else {
+            std::uninitialized_move(other.items, other.items + other.count, items);
+            count = other.count;
+            other.destroyAll();
+        }
+    }
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() noexcept : items(inlineData()) {}
+    SmallVector(const SmallVector& other) : items(inlineData()) {
+        reserve(other.count);
+        std::uninitialized_copy(other.items, other.items + other.count, items);
+        count = other.count;
+    }
+    SmallVector(SmallVector&& other) noexcept : items(inlineData()) { takeFrom(other); }
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            SmallVector copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            destroyAll();
+            releaseHeap();
+            takeFrom(other);
+        }
+        return *this;
+    }
+    ~SmallVector() {
+        destroyAll();
+        releaseHeap();
+    }
+
+    // When it's full, the new element gets built in the new block before the old one is freed – args may well
+    // point into this very vector (v.push_back(v[0])), same as std::vector allows.
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (count < cap) {
+            T* slot = new (items + count) T(std::forward<Args>(args)...);
+            ++count;
+            return *slot;
+        }
+        const size_t newCap = grownCapacity(count + 1);
+        T* fresh = static_cast<T*>(::operator new(newCap * sizeof(T)));
+        T* slot;
+        try {
+            slot = new (fresh + count) T(std::forward<Args>(args)...);
+        } catch (...) {
+            ::operator delete(fresh);
+            throw;
+        }
+        adopt(fresh, newCap);
+        ++count;
+        return *slot;
+    }
+    void push_back(const T& value) { emplace_back(value); }
+    void reserve(size_t wanted) {
+        if (wanted > cap) {
+            grow(wanted);
+        }
+    }
+    // Drops the elements but keeps whatever capacity it had.
+    void clear() noexcept { destroyAll(); }
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    size_t capacity() const noexcept { return cap; }
+    // True while everything still fits in the inline buffer.
+    bool isInline() const noexcept { return !onHeap(); }
+    T& operator[](size_t i) noexcept { return items[i]; }
+    const T& operator[](size_t i) const noexcept { return items[i]; }
+    T* data() noexcept { return items; }
+    const T* data() const noexcept { return items; }
+    iterator begin() noexcept { return items; }
+    iterator end() noexcept { return items + count; }
+    const_iterator begin() const noexcept { return items; }
+    const_iterator end() const noexcept { return items + count; }
+};
+// How many courses a Semester holds without touching the heap. Override with -DCGPA_INLINE_COURSES=<n>.
+#ifndef CGPA_INLINE_COURSES
+#define CGPA_INLINE_COURSES 8
+#endif
+using CourseList = SmallVector<Course, CGPA_INLINE_COURSES>;
+/*
+ * Class: CourseSpan
+ * Read-only window onto a run of courses – size, indexing and range-for, nothing else.
+ */
+class CourseSpan {
+private:
+    const Course* first;
+    size_t count;
+public:
+    CourseSpan(const Course* f, size_t n) noexcept : first(f), count(n) {}
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    const Course& operator[](size_t i) const noexcept { return first[i]; }
+    const Course* begin() const noexcept { return first; }
+    const Course* end() const noexcept { return first + count; }
+};
+/*
+ * Class: SemesterView
+ * A read-only look at one semester's courses wherever they happen to live – a Semester's own list, or a slice
+ * of a Student's flat course array. The GPA math and the course printout live here, so there's only one copy.
+ * It's a couple of pointers, so pass it around by value; it's only valid while the owner is unchanged.
+ */
+class SemesterView {
+private:
+    const Course* first;
+    size_t count;
+    const std::string* term;
+public:
+    SemesterView(const Course* f, size_t n, const std::string* t) noexcept : first(f), count(n), term(t) {}
+    CourseSpan getCourses() const noexcept { return CourseSpan(first, count); }
+    const std::string& getTerm() const noexcept { return *term; }
+    // Calculates the GPA: basically, total points (grade times credits) divided by total credits.
+    // If no credits, it just returns 0 to avoid dividing by zero – safe bet.
+    double calculateGPA() const noexcept {
+        double totalCredits = 0.0, totalPoints = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            totalCredits += first[i].credit;
+            totalPoints += first[i].grade * first[i].credit;
+        }
+        return totalCredits == 0.0 ? 0.0 : totalPoints / totalCredits;
+    }
+    // Prints out the courses nicely, numbered from 1.
+    void displayCourses() const {
+        for (size_t i = 0; i < count; ++i) {
+            std::cout << "Course " << i + 1
+                    << " | Grade: " << first[i].grade
+                    << " | Credit: " << first[i].credit << std::endl;
+        }
+    }
+};
 /*
  * Class: Semester
  * This handles all the courses for one semester, figures out the GPA, and shows the details.
  * I separated this out so the Student class doesn't have to worry about course-level junk.
- * Vectors are perfect here for storing courses – they grow as needed and manage memory automatically.
+ * Courses go in a SmallVector – it grows as needed and manages memory itself, but skips the heap for typical semesters.
  * Made methods const where possible to avoid sneaky changes, and used range-based loops to keep things readable.
  * It's all exception-safe too, meaning it won't throw surprises unless something really goes wrong.
  * Key points: Calculates total credits and grade points for GPA (grade × credit), and displays individual courses.
  */
 class Semester {
 private:
-    std::vector<Course> courses;  // A list of courses; vector's great for fast access and no manual cleanup.
+    CourseList courses;           // Courses live inline for typical semesters and spill to the heap past that.
+    std::string term;             // Optional label like "2024-Fall" – only used for grouping reports.
 public:
+    void setTerm(std::string t) { term = std::move(t); }
+    const std::string& getTerm() const noexcept { return term; }
     // Adds a course by building it right in the vector – saves on copying.
     // Not a huge deal here, but it's a nice efficiency boost.
     void addCourse(double grade, double credit) {
+        CGPA_ALLOC_SCOPE(AllocTag::Ingest);
         courses.emplace_back(grade, credit);
     }
+    // Sizes the course list up front when you already know how many are coming (the loader does).
+    void reserve(size_t count) {
+        courses.reserve(count);
+    }
     // Calculates the GPA: basically, total points (grade times credits) divided by total credits.
     // If no credits, it just returns 0 to avoid dividing by zero – safe bet.
     // Marked const so you can call it on a semester that won't change, and noexcept because it won't throw.
     // Key point: Computes GPA using total credits and grade points (grade × credit).
     double calculateGPA() const noexcept {
-        double totalCredits = 0.0, totalPoints = 0.0;
-        for (const auto& c : courses) {  // Easy loop that won't mess up iterators.
-            totalCredits += c.credit;
-            totalPoints += c.grade * c.credit;
-        }
-        return totalCredits == 0.0 ? 0.0 : totalPoints / totalCredits;
+        return view().calculateGPA();
     }
     // Prints out the courses nicely.
     // Uses cout for output – could swap it out if you want to print to a file instead.
     // Const so it works on semesters you don't want to edit.
     // Key point: Displays individual course grades.
     void displayCourses() const {
-        for (size_t i = 0; i < courses.size(); ++i) {
-            std::cout << "Course " << i + 1
-                    << " | Grade: " << courses[i].grade
-                    << " | Credit: " << courses[i].credit << std::endl;
-        }
+        view().displayCourses();
     }
     // Gives you the list of courses without copying the whole thing – way faster for big lists.
     // It's const so you can't mess with the original, keeping things encapsulated.
     // If you really need to change it, we could add a non-const version later.
-    const std::vector<Course>& getCourses() const noexcept {
+    const CourseList& getCourses() const noexcept {
         return courses;
     }
+    // The same read-only view a Student hands out for its stored semesters, so the math lives in one place.
+    SemesterView view() const noexcept {
+        return SemesterView(courses.data(), courses.size(), &term);
+    }
+};
+class Student;
+/*
+ * Class: SemesterBuilder
+ * What Student::emplaceSemester() hands back: courses you add go straight onto the end of the student's flat course
+ * array – no temporary Semester, no second copy. commit() seals them off as a semester. If the builder goes out
+ * of scope without a commit (say, input blew up halfway), the half-built semester is rolled back – RAII again.
+ * Only one builder can be open per student at a time, it's move-only, and the student must stay put (no moving
+ * or copying it) until the builder is committed or gone.
+ */
+class SemesterBuilder {
+private:
+    Student* owner;
+    size_t start;
+    friend class Student;
+    SemesterBuilder(Student& s, size_t firstCourse) noexcept : owner(&s), start(firstCourse) {}
+public:
+    SemesterBuilder(SemesterBuilder&& other) noexcept : owner(std::exchange(other.owner, nullptr)), start(other.start) {}
+    SemesterBuilder(const SemesterBuilder&) = delete;
+    SemesterBuilder& operator=(const SemesterBuilder&) = delete;
+    SemesterBuilder& operator=(SemesterBuilder&&) = delete;
+    ~SemesterBuilder();
+    void addCourse(double grade, double credit);
+    void reserve(size_t courseCount);
+    size_t size() const noexcept;
+    void commit(std::string term = std::string());
+};
+/*
+ * Class: SemesterRange
+ * What Student::getSemesters() returns: something you can index, size and range-for over, yielding SemesterViews.
+ */
+class SemesterRange {
+private:
+    const Course* courses;
+    const size_t* ends;
+    const std::string* terms;
+    size_t count;
+public:
+    class Iterator {
+    private:
+        const SemesterRange* range;
+        size_t index;
+    public:
+        Iterator(const SemesterRange* r, size_t i) noexcept : range(r), index(i) {}
+        SemesterView operator*() const noexcept { return (*range)[index]; }
+        Iterator& operator++() noexcept {
+            ++index;
+            return *this;
+        }
+        bool operator!=(const Iterator& other) const noexcept { return index != other.index; }
+        bool operator==(const Iterator& other) const noexcept { return index == other.index; }
+    };
+    SemesterRange(const Course* c, const size_t* e, const std::string* t, size_t n) noexcept
+        : courses(c), ends(e), terms(t), count(n) {}
+    size_t size() const noexcept { return count; }
+    bool empty() const noexcept { return count == 0; }
+    SemesterView operator[](size_t i) const noexcept {
+        const size_t start = i == 0 ? 0 : ends[i - 1];
+        return SemesterView(courses + start, ends[i] - start, terms + i);
+    }
+    Iterator begin() const noexcept { return Iterator(this, 0); }
+    Iterator end() const noexcept { return Iterator(this, count); }
 };
 /*
  * Class: Student
  * This ties everything together – holds all the semesters, computes the big CGPA, and deals with saving/loading.
  * Keeps the multi-semester stuff separate from the semester details, which makes the code cleaner.
+ * Storage is flat: every course of every semester sits in one contiguous array, and a second array records where
+ * each semester ends (CSR-style). The CGPA is then one straight pass over memory instead of hopping through a
+ * separate allocation per semester, and a load only needs a fixed handful of allocations. Semester is still what
+ * you build and hand in; reading back gives you SemesterViews into the flat array.
  * File operations are handled with RAII so they close automatically, and I added exceptions for when things go south.
  * The save/load uses a plain text format that's easy to read, but you could fancy it up with JSON if you want.
  * Input checks prevent loading junk data.
@@ -111,74 +1023,305 @@ public:
  */
 class Student {
 private:
-    std::vector<Semester> semesters;  // Just a list of semesters – grows as you add them.
+    // True while a SemesterBuilder is open on this student. It never travels to another object – the builder
+    // belongs to this one. Copying a student mid-build throws (the copy would keep the uncommitted courses with
+    // no semester to own them), and so does assigning over one. Moves just start the new object off idle.
+    // Declared first so those throws happen before any other member has been touched.
+    struct BuildingFlag {
+        bool on = false;
+        BuildingFlag() = default;
+        BuildingFlag(const BuildingFlag& other) {
+            if (other.on) {
+                throw std::logic_error("Can't copy a student while a semester is being built for it.");
+            }
+        }
+        BuildingFlag(BuildingFlag&&) noexcept {}
+        BuildingFlag& operator=(BuildingFlag&& other) { return *this = static_cast<const BuildingFlag&>(other); }
+        BuildingFlag& operator=(const BuildingFlag&) {
+            if (on) {
+                throw std::logic_error("Can't replace a student while a semester is being built for it.");
+            }
+            return *this;
+        }
+    };
+    BuildingFlag building;
+    std::vector<Course> courses;        // Every course, semester after semester, back to back.
+    std::vector<size_t> semesterEnds;   // Semester i covers courses [end of i-1, semesterEnds[i]).
+    std::vector<std::string> terms;     // Term label per semester (empty if not set).
+    // Optional grouping keys for cohort reports. Empty means "not set"; nothing in the GPA math looks at them.
+    std::string department;
+    std::string batch;
+
+    // Every mutator goes through this first: with a builder open, the half-built semester sits at the end of the
+    // course array, and anything else touching the storage would leave the builder's rollback pointing at junk.
+    void requireNoBuilder() const {
+        if (building.on) {
+            throw std::logic_error("A semester is still being built for this student.");
+        }
+    }
+    void clearSemesters() noexcept {
+        courses.clear();
+        semesterEnds.clear();
+        terms.clear();
+    }
+    friend class SemesterBuilder;
 public:
-    // Adds a semester using move to avoid copying the whole thing.
-    // Efficient for when semesters get big.
+    void setDepartment(std::string d) { department = std::move(d); }
+    void setBatch(std::string b) { batch = std::move(b); }
+    const std::string& getDepartment() const noexcept { return department; }
+    const std::string& getBatch() const noexcept { return batch; }
+    // Read-only views of the semesters, for the cohort tools that need per-semester detail.
+    // Don't hold on to it across changes to the student – the views point into its storage.
+    SemesterRange getSemesters() const noexcept {
+        return SemesterRange(courses.data(), semesterEnds.data(), terms.data(), semesterEnds.size());
+    }
+    // Starts a semester that gets written in place – see SemesterBuilder. Throws std::logic_error if another
+    // builder is still open on this student.
+    SemesterBuilder emplaceSemester() {
+        if (building.on) {
+            throw std::logic_error("A semester is already being built for this student.");
+        }
+        building.on = true;
+        return SemesterBuilder(*this, courses.size());
+    }
+    // Sizes the flat storage up front when you know roughly what's coming, so adds don't regrow it.
+    void reserve(size_t semesterCount, size_t courseCount) {
+        requireNoBuilder();
+        courses.reserve(courseCount);
+        semesterEnds.reserve(semesterCount);
+        terms.reserve(semesterCount);
+    }
+    // Appends the semester's courses onto the flat array and records where it ends.
     void addSemester(Semester sem) {
-        semesters.push_back(std::move(sem));
+        requireNoBuilder();
+        CGPA_ALLOC_SCOPE(AllocTag::Ingest);
+        const auto& incoming = sem.getCourses();
+        courses.insert(courses.end(), incoming.begin(), incoming.end());
+        semesterEnds.push_back(courses.size());
+        terms.push_back(sem.getTerm());
+        Instrumentation::instance().count(Counter::SemestersAdded);
     }
     // Figures out the overall CGPA by crunching all courses across semesters.
-    // Same math as the semester GPA, just bigger scale.
+    // Same math as the semester GPA, just bigger scale – and with the flat layout it's one linear pass.
     // Const and noexcept for safety – no changes, no surprises.
     // Key point: Computes overall CGPA using total credits and grade points across all semesters.
     double calculateCGPA() const noexcept {
-        double totalCredits = 0.0, totalPoints = 0.0;
-        for (const auto& sem : semesters) {
-            for (const auto& c : sem.getCourses()) {
-                totalCredits += c.credit;
-                totalPoints += c.grade * c.credit;
-            }
+        CGPA_TIME_SCOPE(Probe::CalculateCGPA);
+        double credits = 0.0, points = 0.0;
+        for (const auto& c : courses) {
+            credits += c.credit;
+            points += c.grade * c.credit;
         }
-        return totalCredits == 0.0 ? 0.0 : totalPoints / totalCredits;
+        return credits == 0.0 ? 0.0 : points / credits;
+    }
+    // Running totals across every semester – the raw ingredients of the CGPA.
+    // Exposed so planners and cohort tools can do their own math without re-dividing.
+    double totalCredits() const noexcept {
+        double total = 0.0;
+        for (const auto& c : courses) {
+            total += c.credit;
+        }
+        return total;
+    }
+    double totalPoints() const noexcept {
+        double total = 0.0;
+        for (const auto& c : courses) {
+            total += c.grade * c.credit;
+        }
+        return total;
+    }
+    // Works out the average grade you'd need over plannedCredits more credits to land on targetCGPA.
+    // It's just the CGPA formula solved for the unknown: (target * (C + P) - points) / P.
+    // Anything above 10 means the target is out of reach; it never goes below 0 since you can't score negative.
+    // Throws InvalidCreditException if there are no planned credits, because then the question makes no sense.
+    double requiredAverageGrade(double targetCGPA, double plannedCredits) const {
+        if (plannedCredits <= 0.0) {
+            throw InvalidCreditException("Planned credits must be positive.");
+        }
+        const double needed = (targetCGPA * (totalCredits() + plannedCredits) - totalPoints()) / plannedCredits;
+        return std::max(0.0, needed);
     }
     // Saves everything to a file in a simple format: number of courses, then grade and credit for each.
     // Text is human-readable and works everywhere. RAII means the file closes even if something breaks.
     // If it can't open, it throws an error so you know what happened.
-    void saveToFile() {
+    // The path defaults to the usual cgpa_data.txt; pass another one to keep one file per student.
+    void saveToFile(const std::string& path = "cgpa_data.txt") {
+        CGPA_TIME_SCOPE(Probe::SaveToFile);
+        CGPA_ALLOC_SCOPE(AllocTag::Persistence);
         try {
-            std::ofstream file("cgpa_data.txt");
+            std::ofstream file(path);
             if (!file) {
                 throw std::runtime_error("Failed to open file for saving.");
             }
-            for (const auto& sem : semesters) {
-                file << sem.getCourses().size() << std::endl;
-                for (const auto& c : sem.getCourses()) {
-                    file << c.grade << " " << c.credit << std::endl;
-                }
-            }
+            writeRecords(file);
+            Instrumentation::instance().count(Counter::Saves);
             std::cout << "Data saved successfully." << std::endl;
         } catch (const std::exception& e) {
             std::cerr << "Error saving data: " << e.what() << std::endl;
         }
     }
-    // Loads data from the file, wiping out what's there first.
-    // If no file, it just tells you and moves on. Exceptions catch bad data or I/O issues.
-    // Clears everything on error to avoid half-loaded messes.
-    void loadFromFile() {
-        try {
-            std::ifstream file("cgpa_data.txt");
-            if (!file) {
-                std::cout << "No saved data found." << std::endl;
+    // Writes the saved format to any stream – the other half of readRecords, also quiet.
+    // It starts with a "CGPA2 <semesters> <courses>" header so the loader can size everything up front;
+    // after that it's the same old per-semester records. The grouping keys ride along as optional
+    // "<key> <text>" lines – "department" and "batch" after the header, "term" just before the semester it
+    // labels – and only when they're set, so a file without any looks exactly like before.
+    // A key's text is one line, so any line breaks in it get written as spaces.
+    void writeRecords(std::ostream& out) const {
+        auto writeKey = [&out](const char* key, const std::string& text) {
+            if (text.empty()) {
                 return;
             }
-            semesters.clear();
-            int courseCount;
-            while (file >> courseCount) {
-                Semester sem;
-                for (int i = 0; i < courseCount; ++i) {
-                    double g, c;
-                    if (!(file >> g >> c)) {
-                        throw std::runtime_error("Corrupt data in file.");
-                    }
-                    sem.addCourse(g, c);
+            out << key << ' ';
+            for (char ch : text) {
+                out << (ch == '\n' || ch == '\r' ? ' ' : ch);
+            }
+            out << '\n';
+        };
+        out << "CGPA2 " << semesterEnds.size() << " " << courses.size() << '\n';
+        writeKey("department", department);
+        writeKey("batch", batch);
+        for (const auto& sem : getSemesters()) {
+            writeKey("term", sem.getTerm());
+            out << sem.getCourses().size() << '\n';
+            for (const auto& c : sem.getCourses()) {
+                out << c.grade << " " << c.credit << '\n';
+            }
+        }
+        out.flush();
+    }
+    // Parses the saved format from any stream, replacing what's there. Quiet on purpose (no "loaded" message),
+    // so bulk loaders can reuse it; throws on corrupt data and leaves the caller to decide what to do about it.
+    // The stream gets read into one buffer (sized up front when it can seek) and handed to the tokenizer.
+    void readRecords(std::istream& in) {
+        requireNoBuilder();
+        CGPA_ALLOC_SCOPE(AllocTag::Persistence);
+        std::string data;
+        const std::istream::pos_type start = in.tellg();
+        if (start != std::istream::pos_type(-1)) {
+            if (in.seekg(0, std::ios::end)) {
+                const std::istream::pos_type stop = in.tellg();
+                if (stop != std::istream::pos_type(-1) && stop > start) {
+                    data.reserve(static_cast<size_t>(stop - start));
                 }
-                semesters.push_back(std::move(sem));
+                in.seekg(start);
+            } else {
+                in.clear();
             }
+        }
+        char chunk[1 << 14];
+        while (in.read(chunk, sizeof chunk) || in.gcount() > 0) {
+            data.append(chunk, static_cast<size_t>(in.gcount()));
+        }
+        readRecords(data.data(), data.size());
+    }
+    // Same, for file contents that are already sitting in memory.
+    void readRecords(const char* data, size_t size) {
+        InputTokenizer in(data, size);
+        readRecords(in);
+    }
+    // The actual parser. With a CGPA2 header, the flat arrays get sized exactly once from it – a load is a fixed
+    // few allocations no matter how big the file is – and the header totals have to match what's actually there.
+    // Old header-less files still load fine, just without the up-front sizing. Anything that isn't a number where
+    // a number should be counts as corrupt, except the department/batch/term key lines writeRecords puts out.
+    // Department and batch get replaced too – a file without them leaves them unset.
+    void readRecords(InputTokenizer& in) {
+        requireNoBuilder();
+        CGPA_ALLOC_SCOPE(AllocTag::Persistence);
+        clearSemesters();
+        department.clear();
+        batch.clear();
+        uint64_t parsed = 0;  // Tallied locally and reported once, so the counter stays off the per-course path.
+        auto corrupt = [&parsed]() {
+            Instrumentation::instance().count(Counter::CoursesParsed, parsed);
+            Instrumentation::instance().count(Counter::LoadErrors);
+            return std::runtime_error("Corrupt data in file.");
+        };
+        const size_t sanityLimit = 100000000;  // Keeps a garbage header from asking for terabytes.
+        bool hasHeader = false;
+        size_t expectedSemesters = 0, expectedCourses = 0;
+        if (in.peek() == 'C') {
+            std::string magic;
+            if (in.nextWord(magic) != TokenStatus::Ok || magic != "CGPA2" ||
+                in.next(expectedSemesters) != TokenStatus::Ok || in.next(expectedCourses) != TokenStatus::Ok ||
+                expectedSemesters > sanityLimit || expectedCourses > sanityLimit) {
+                throw corrupt();
+            }
+            hasHeader = true;
+            courses.reserve(expectedCourses);
+            semesterEnds.reserve(expectedSemesters);
+            terms.reserve(expectedSemesters);
+        }
+        std::string pendingTerm;  // From a "term" line, waiting for its semester.
+        while (true) {
+            const int next = in.peek();
+            if (next == EOF) {
+                break;
+            }
+            if (std::isalpha(next)) {
+                std::string key;
+                const char* first;
+                const char* last;
+                in.nextWord(key);
+                in.restOfLine(first, last);
+                while (first < last && std::isspace(static_cast<unsigned char>(*first))) {
+                    ++first;
+                }
+                while (last > first && std::isspace(static_cast<unsigned char>(last[-1]))) {
+                    --last;
+                }
+                if (key == "term") {
+                    pendingTerm.assign(first, last);
+                } else if (key == "department") {
+                    department.assign(first, last);
+                } else if (key == "batch") {
+                    batch.assign(first, last);
+                } else {
+                    throw corrupt();
+                }
+                continue;
+            }
+            int courseCount;
+            if (in.next(courseCount) != TokenStatus::Ok || courseCount < 0 ||
+                static_cast<size_t>(courseCount) > sanityLimit) {
+                throw corrupt();
+            }
+            for (int i = 0; i < courseCount; ++i) {
+                double g, c;
+                // from_chars happily reads "nan" and "inf", which operator>> never did – those are corrupt too.
+                if (in.next(g) != TokenStatus::Ok || in.next(c) != TokenStatus::Ok || !std::isfinite(g) ||
+                    !std::isfinite(c)) {
+                    throw corrupt();
+                }
+                courses.emplace_back(g, c);
+                ++parsed;
+            }
+            semesterEnds.push_back(courses.size());
+            terms.push_back(std::move(pendingTerm));
+            pendingTerm.clear();
+        }
+        if (!pendingTerm.empty() ||
+            (hasHeader && (semesterEnds.size() != expectedSemesters || parsed != expectedCourses))) {
+            throw corrupt();
+        }
+        Instrumentation::instance().count(Counter::CoursesParsed, parsed);
+    }
+    // Loads data from the file, wiping out what's there first.
+    // If no file, it just tells you and moves on. Exceptions catch bad data or I/O issues.
+    // Clears everything on error to avoid half-loaded messes.
+    void loadFromFile(const std::string& path = "cgpa_data.txt") {
+        requireNoBuilder();  // Outside the try – the error path below clears everything.
+        CGPA_TIME_SCOPE(Probe::LoadFromFile);
+        try {
+            std::ifstream file(path);
+            if (!file) {
+                std::cout << "No saved data found." << std::endl;
+                return;
+            }
+            readRecords(file);
             std::cout << "Data loaded successfully." << std::endl;
         } catch (const std::exception& e) {
             std::cerr << "Error loading data: " << e.what() << std::endl;
-            semesters.clear();  // Reset on error to avoid partial loads.
+            clearSemesters();  // Reset on error to avoid partial loads.
         }
     }
     // Shows all semesters with their GPAs, plus the final CGPA, formatted nicely.
@@ -186,34 +1329,2887 @@ public:
     // Key points: Displays individual course grades (via displayCourses) and the final CGPA.
     void displayAll() const {
         std::cout << std::fixed << std::setprecision(2);
-        for (size_t i = 0; i < semesters.size(); ++i) {
+        const SemesterRange sems = getSemesters();
+        for (size_t i = 0; i < sems.size(); ++i) {
             std::cout << "\nSemester " << i + 1 << ":" << std::endl;
-            semesters[i].displayCourses();
-            std::cout << "GPA: " << semesters[i].calculateGPA() << std::endl;
+            sems[i].displayCourses();
+            std::cout << "GPA: " << sems[i].calculateGPA() << std::endl;
         }
         std::cout << "\nFinal CGPA: " << calculateCGPA() << std::endl;//C:/MinGW/bin/g++.exe
     }
 };
+// SemesterBuilder's members need the full Student, so they're defined down here.
+inline SemesterBuilder::~SemesterBuilder() {
+    if (owner != nullptr) {
+        // Never committed – drop the half-built semester.
+        owner->courses.erase(owner->courses.begin() + static_cast<std::ptrdiff_t>(start), owner->courses.end());
+        owner->building.on = false;
+    }
+}
+inline void SemesterBuilder::addCourse(double grade, double credit) {
+    CGPA_ALLOC_SCOPE(AllocTag::Ingest);
+    owner->courses.emplace_back(grade, credit);
+}
+// Grows geometrically like push_back would – reserving the exact size here would reallocate (and copy the whole
+// flat array) for every single semester.
+inline void SemesterBuilder::reserve(size_t courseCount) {
+    std::vector<Course>& all = owner->courses;
+    if (start + courseCount > all.capacity()) {
+        all.reserve(std::max(start + courseCount, 2 * all.capacity()));
+    }
+}
+inline size_t SemesterBuilder::size() const noexcept {
+    return owner->courses.size() - start;
+}
+inline void SemesterBuilder::commit(std::string term) {
+    CGPA_ALLOC_SCOPE(AllocTag::Ingest);
+    if (owner == nullptr) {
+        throw std::logic_error("Semester was already committed.");
+    }
+    owner->semesterEnds.push_back(owner->courses.size());
+    owner->terms.push_back(std::move(term));
+    owner->building.on = false;
+    owner = nullptr;
+    Instrumentation::instance().count(Counter::SemestersAdded);
+}
+/*
+ * Function: requiredAverageGrades
+ * Batch version of Student::requiredAverageGrade for a whole cohort (think the nightly run over every student).
+ * First pass pulls each student's totals into two flat arrays, then the second pass is a plain arithmetic loop
+ * with no branches or pointer chasing, so the compiler can vectorize it. Way cheaper than poking calculateCGPA
+ * over and over with guessed grades.
+ * Same rules as the single-student version: > 10 means unreachable, and non-positive planned credits throw.
+ */
+std::vector<double> requiredAverageGrades(const std::vector<Student>& cohort, double targetCGPA, double plannedCredits) {
+    if (plannedCredits <= 0.0) {
+        throw InvalidCreditException("Planned credits must be positive.");
+    }
+    const size_t n = cohort.size();
+    std::vector<double> credits(n), points(n), needed(n);
+    for (size_t i = 0; i < n; ++i) {
+        credits[i] = cohort[i].totalCredits();
+        points[i] = cohort[i].totalPoints();
+    }
+    const double inversePlanned = 1.0 / plannedCredits;
+    for (size_t i = 0; i < n; ++i) {
+        needed[i] = std::max(0.0, (targetCGPA * (credits[i] + plannedCredits) - points[i]) * inversePlanned);
+    }
+    return needed;
+}
+/*
+ * Class: TaskScheduler
+ * A work-stealing thread pool that every cohort-wide job goes through, so nothing has to juggle std::thread by hand.
+ * Each worker owns a deque: it takes its own work from the back (freshest, still warm in cache) and, when it runs
+ * dry, steals from the front of someone else's. That's what keeps things balanced when one chunk is full of
+ * 20-semester transcripts and another is all first-years – idle workers just go help.
+ * Deques are guarded by their own small mutex rather than being lock-free; contention only happens during a steal,
+ * which is rare next to the actual GPA work.
+ * Tasks submitted from a worker land on that worker's deque; tasks from outside get spread round-robin.
+ */
+class TaskScheduler {
+private:
+    struct Worker {
+        std::deque<std::function<void()>> tasks;
+        std::mutex lock;
+    };
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::vector<std::thread> threads;
+    std::atomic<size_t> nextQueue{0};
+    size_t pending = 0;               // Queued but not yet picked up – guarded by sleepLock.
+    bool stopping = false;            // Also guarded by sleepLock.
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    // Which worker (if any) the current thread is, so submit() and helpers know their home deque.
+    inline static thread_local const TaskScheduler* currentPool = nullptr;
+    inline static thread_local size_t currentIndex = 0;
+
+    bool popLocal(size_t index, std::function<void()>& task) {
+        Worker& w = *workers[index];
+        std::lock_guard<std::mutex> guard(w.lock);
+        if (w.tasks.empty()) {
+            return false;
+        }
+        task = std::move(w.tasks.back());
+        w.tasks.pop_back();
+        return true;
+    }
+    bool steal(size_t thief, std::function<void()>& task) {
+        const size_t n = workers.size();
+        for (size_t offset = 1; offset <= n; ++offset) {
+            Worker& victim = *workers[(thief + offset) % n];
+            std::lock_guard<std::mutex> guard(victim.lock);
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+    void workerLoop(size_t index) {
+        currentPool = this;
+        currentIndex = index;
+        while (true) {
+            if (!tryRunOne()) {
+                std::unique_lock<std::mutex> lk(sleepLock);
+                wake.wait(lk, [this]() { return stopping || pending > 0; });
+                if (stopping && pending == 0) {
+                    return;
+                }
+            }
+        }
+    }
+public:
+    explicit TaskScheduler(size_t workerCount = std::max<size_t>(1, std::thread::hardware_concurrency())) {
+        workerCount = std::max<size_t>(1, workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            workers.push_back(std::make_unique<Worker>());
+        }
+        threads.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; ++i) {
+            threads.emplace_back([this, i]() { workerLoop(i); });
+        }
+    }
+    // Drains whatever is still queued, then joins – RAII, so no dangling threads at exit.
+    ~TaskScheduler() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& t : threads) {
+            t.join();
+        }
+    }
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+    size_t workerCount() const noexcept { return workers.size(); }
+    void submit(std::function<void()> task) {
+        const size_t home = currentPool == this ? currentIndex : nextQueue++ % workers.size();
+        // Count it before anyone can see it: a worker that grabs the task straight away decrements pending, and
+        // that must never happen before the increment (pending would wrap and sleeping workers would spin).
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            ++pending;
+        }
+        try {
+            std::lock_guard<std::mutex> guard(workers[home]->lock);
+            workers[home]->tasks.push_back(std::move(task));
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            --pending;
+            throw;
+        }
+        wake.notify_one();
+    }
+    // Runs one queued task on the calling thread if there is one. Workers use it in their loop, and anyone
+    // waiting on a TaskGroup uses it to help out before blocking (which also keeps nested jobs from deadlocking).
+    bool tryRunOne() {
+        const size_t home = currentPool == this ? currentIndex : 0;
+        std::function<void()> task;
+        if (!(currentPool == this && popLocal(home, task)) && !steal(home, task)) {
+            return false;
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            --pending;
+        }
+        task();
+        return true;
+    }
+};
+/*
+ * Function: sharedScheduler
+ * The one pool the whole program shares, created on first use and torn down at exit.
+ */
+inline TaskScheduler& sharedScheduler() {
+    static TaskScheduler scheduler;
+    return scheduler;
+}
+/*
+ * Class: TaskGroup
+ * A batch of tasks you can wait on as a whole. wait() pitches in on queued work, and only once there's nothing left
+ * to pick up does it sleep until the last task finishes. The first exception any task throws gets rethrown there,
+ * so errors don't vanish on a worker thread.
+ */
+class TaskGroup {
+private:
+    TaskScheduler& pool;
+    size_t outstanding = 0;  // Guarded by doneLock.
+    std::mutex doneLock;
+    std::condition_variable done;
+    std::exception_ptr firstError;
+    std::mutex errorLock;
+
+    // "Finished" is only ever decided under doneLock, so the last task is out of the lock (and never touches the
+    // group again) before the waiter can return and let the group be destroyed.
+    bool finished() {
+        std::lock_guard<std::mutex> guard(doneLock);
+        return outstanding == 0;
+    }
+    void helpUntilDone() {
+        while (!finished()) {
+            if (pool.tryRunOne()) {
+                continue;
+            }
+            // Nothing queued anywhere, so all our tasks are already running. The timeout is just a safety net: a
+            // running task can still queue more work for us, and then we'd rather help than keep sleeping.
+            std::unique_lock<std::mutex> lk(doneLock);
+            done.wait_for(lk, std::chrono::milliseconds(1), [this]() { return outstanding == 0; });
+        }
+    }
+public:
+    explicit TaskGroup(TaskScheduler& p = sharedScheduler()) : pool(p) {}
+    // Waits out anything still running so tasks never outlive the state they captured.
+    ~TaskGroup() { helpUntilDone(); }
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> fn) {
+        {
+            std::lock_guard<std::mutex> guard(doneLock);
+            ++outstanding;
+        }
+        pool.submit([this, fn = std::move(fn)]() {
+            try {
+                fn();
+            } catch (...) {
+                std::lock_guard<std::mutex> guard(errorLock);
+                if (!firstError) {
+                    firstError = std::current_exception();
+                }
+            }
+            std::lock_guard<std::mutex> guard(doneLock);
+            if (--outstanding == 0) {
+                done.notify_all();
+            }
+        });
+    }
+    void wait() {
+        helpUntilDone();
+        if (firstError) {
+            std::rethrow_exception(std::exchange(firstError, nullptr));
+        }
+    }
+};
+/*
+ * Function: parallelFor
+ * Chops [0, count) into chunks and runs fn(begin, end) on each through the shared scheduler.
+ * There are several chunks per worker on purpose: if some chunks turn out heavier (long transcripts),
+ * the workers that finish early steal the leftovers instead of sitting idle.
+ * Small jobs just run inline – handing a few students to the pool costs more than it saves.
+ * fn has to be safe to call concurrently on disjoint ranges; anything it throws comes back out of here.
+ */
+template <typename Fn>
+void parallelFor(size_t count, Fn fn) {
+    const size_t minChunk = 256;
+    if (count <= minChunk) {
+        fn(size_t{0}, count);
+        return;
+    }
+    TaskScheduler& pool = sharedScheduler();
+    const size_t chunk = std::max(minChunk, count / (pool.workerCount() * 8) + 1);
+    TaskGroup group(pool);
+    for (size_t begin = 0; begin < count; begin += chunk) {
+        const size_t end = std::min(count, begin + chunk);
+        group.run([&fn, begin, end]() { fn(begin, end); });
+    }
+    group.wait();
+}
+/*
+ * Class: CohortRanking
+ * Class rank and percentile for everyone in a cohort, so nobody has to compute and sort CGPAs externally.
+ * CGPAs get computed in parallel and turned into fixed-point integer keys (4 decimals), which lets me use a
+ * two-pass LSD radix sort instead of a comparison sort – linear time, and stable, so ties stay in index order.
+ * Ranks are "competition" style: equal CGPAs share a rank and the next rank skips ahead (1, 2, 2, 4).
+ * Percentile is the share of the cohort with a strictly lower CGPA.
+ * After a term where only a few students changed, update() pulls those few out, re-sorts just them, and merges
+ * them back in – O(n + k log k) instead of redoing the whole thing.
+ */
+class CohortRanking {
+private:
+    static constexpr double keyScale = 10000.0;   // 4 decimal places is plenty to separate CGPAs.
+    static constexpr unsigned radixBits = 11;     // Two 11-bit passes cover every key up to 2^22.
+    static constexpr uint32_t maxKey = (1u << (2 * radixBits)) - 1;
+    std::vector<uint32_t> keys;     // Fixed-point CGPA per student, indexed like the cohort.
+    std::vector<size_t> order;      // Student indices, best CGPA first.
+    std::vector<size_t> ranks;      // 1-based rank per student.
+    std::vector<double> percentiles;
+
+    static uint32_t toKey(double cgpa) noexcept {
+        // NaN (fails the first test) and anything at or below zero rank last; infinity and overflow rank top.
+        // llround on those would be undefined, so they never reach it.
+        if (!(cgpa > 0.0)) {
+            return 0;
+        }
+        if (cgpa * keyScale >= static_cast<double>(maxKey)) {
+            return maxKey;
+        }
+        const long long k = std::llround(cgpa * keyScale);
+        return static_cast<uint32_t>(std::min<long long>(std::max<long long>(k, 0), maxKey));
+    }
+    // Best-first with ties broken by index, the same order the stable radix sort produces.
+    bool ranksBefore(size_t a, size_t b) const noexcept {
+        return keys[a] != keys[b] ? keys[a] > keys[b] : a < b;
+    }
+    void radixSortOrder() {
+        const size_t n = keys.size();
+        std::vector<size_t> scratch(n);
+        order.resize(n);
+        for (size_t i = 0; i < n; ++i) {
+            order[i] = i;
+        }
+        const uint32_t mask = (1u << radixBits) - 1;
+        for (unsigned pass = 0; pass < 2; ++pass) {
+            const unsigned shift = pass * radixBits;
+            std::vector<size_t> counts(size_t{1} << radixBits, 0);
+            // Inverting the key gives a descending sort out of a normal ascending radix pass.
+            for (size_t idx : order) {
+                ++counts[((maxKey - keys[idx]) >> shift) & mask];
+            }
+            size_t running = 0;
+            for (auto& c : counts) {
+                const size_t here = c;
+                c = running;
+                running += here;
+            }
+            for (size_t idx : order) {
+                scratch[counts[((maxKey - keys[idx]) >> shift) & mask]++] = idx;
+            }
+            order.swap(scratch);
+        }
+    }
+    // One walk over the sorted order hands out ranks and percentiles to each run of equal keys.
+    void assignRanks() {
+        const size_t n = order.size();
+        ranks.assign(n, 0);
+        percentiles.assign(n, 0.0);
+        size_t groupStart = 0;
+        while (groupStart < n) {
+            size_t groupEnd = groupStart + 1;
+            while (groupEnd < n && keys[order[groupEnd]] == keys[order[groupStart]]) {
+                ++groupEnd;
+            }
+            const double pct = 100.0 * static_cast<double>(n - groupEnd) / static_cast<double>(n);
+            for (size_t i = groupStart; i < groupEnd; ++i) {
+                ranks[order[i]] = groupStart + 1;
+                percentiles[order[i]] = pct;
+            }
+            groupStart = groupEnd;
+        }
+    }
+public:
+    // Full re-rank: parallel CGPA pass, radix sort, then ranks.
+    void rankAll(const std::vector<Student>& cohort) {
+        keys.resize(cohort.size());
+        parallelFor(cohort.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                keys[i] = toKey(cohort[i].calculateCGPA());
+            }
+        });
+        radixSortOrder();
+        assignRanks();
+    }
+    // Incremental re-rank when only the students in `changed` were touched.
+    // If the cohort grew or shrank, the old order is useless, so it falls back to rankAll.
+    void update(const std::vector<Student>& cohort, std::vector<size_t> changed) {
+        if (cohort.size() != keys.size()) {
+            rankAll(cohort);
+            return;
+        }
+        std::sort(changed.begin(), changed.end());
+        changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+        std::vector<char> isChanged(keys.size(), 0);
+        for (size_t idx : changed) {
+            if (idx >= keys.size()) {
+                throw std::out_of_range("Changed student index is outside the cohort.");
+            }
+            isChanged[idx] = 1;
+            keys[idx] = toKey(cohort[idx].calculateCGPA());
+        }
+        // Everyone who didn't change is still correctly ordered, so just drop the changed ones...
+        order.erase(std::remove_if(order.begin(), order.end(), [&](size_t idx) { return isChanged[idx] != 0; }),
+                    order.end());
+        // ...sort the small changed set and merge it back in.
+        std::sort(changed.begin(), changed.end(), [this](size_t a, size_t b) { return ranksBefore(a, b); });
+        std::vector<size_t> merged;
+        merged.reserve(keys.size());
+        std::merge(order.begin(), order.end(), changed.begin(), changed.end(), std::back_inserter(merged),
+                   [this](size_t a, size_t b) { return ranksBefore(a, b); });
+        order.swap(merged);
+        assignRanks();
+    }
+    size_t rankOf(size_t student) const { return ranks.at(student); }
+    double percentileOf(size_t student) const { return percentiles.at(student); }
+    double cgpaOf(size_t student) const { return keys.at(student) / keyScale; }
+    // Student indices from top of the class down.
+    const std::vector<size_t>& getOrder() const noexcept { return order; }
+};
+/*
+ * Struct: CohortEntry
+ * A student's position in the cohort vector plus their CGPA – what the honours-list queries hand back.
+ */
+struct CohortEntry {
+    size_t student;
+    double cgpa;
+};
+// Higher CGPA first, lower index first on ties – same tie rule as CohortRanking so the lists agree.
+// NaN compares false against everything, which would break the heap and the sort, so it counts as -infinity here
+// (it ranks last, same as toKey puts it).
+inline bool entryBefore(const CohortEntry& a, const CohortEntry& b) noexcept {
+    const double ka = std::isnan(a.cgpa) ? -std::numeric_limits<double>::infinity() : a.cgpa;
+    const double kb = std::isnan(b.cgpa) ? -std::numeric_limits<double>::infinity() : b.cgpa;
+    return ka != kb ? ka > kb : a.student < b.student;
+}
+/*
+ * Function: topKStudents
+ * Dean's-list style "best k" without sorting the whole cohort.
+ * Every worker keeps a bounded heap of its own best k (worst of those on top, so it's the one that gets kicked out),
+ * then the per-worker heaps get folded into one under a lock. That's O(n log k) overall, and only the final k get sorted.
+ */
+std::vector<CohortEntry> topKStudents(const std::vector<Student>& cohort, size_t k) {
+    if (k == 0) {
+        return {};
+    }
+    auto worstOnTop = [](const CohortEntry& a, const CohortEntry& b) { return entryBefore(a, b); };
+    using BoundedHeap = std::priority_queue<CohortEntry, std::vector<CohortEntry>, decltype(worstOnTop)>;
+    auto offer = [k](BoundedHeap& heap, const CohortEntry& e) {
+        if (heap.size() < k) {
+            heap.push(e);
+        } else if (entryBefore(e, heap.top())) {
+            heap.pop();
+            heap.push(e);
+        }
+    };
+    BoundedHeap best(worstOnTop);
+    std::mutex mergeLock;
+    parallelFor(cohort.size(), [&](size_t begin, size_t end) {
+        BoundedHeap local(worstOnTop);
+        for (size_t i = begin; i < end; ++i) {
+            offer(local, CohortEntry{i, cohort[i].calculateCGPA()});
+        }
+        std::lock_guard<std::mutex> guard(mergeLock);
+        while (!local.empty()) {
+            offer(best, local.top());
+            local.pop();
+        }
+    });
+    std::vector<CohortEntry> result;
+    result.reserve(best.size());
+    while (!best.empty()) {
+        result.push_back(best.top());
+        best.pop();
+    }
+    std::reverse(result.begin(), result.end());  // Heap pops worst-first, so flip it to best-first.
+    return result;
+}
+/*
+ * Function: studentsAtOrAbove
+ * Everyone with a CGPA of at least `threshold` (the honours cut-off), best first.
+ * Workers filter their chunk into a local list and splice it in at the end, so the only sort is over the hits.
+ */
+std::vector<CohortEntry> studentsAtOrAbove(const std::vector<Student>& cohort, double threshold) {
+    std::vector<CohortEntry> result;
+    std::mutex mergeLock;
+    parallelFor(cohort.size(), [&](size_t begin, size_t end) {
+        std::vector<CohortEntry> local;
+        for (size_t i = begin; i < end; ++i) {
+            const double cgpa = cohort[i].calculateCGPA();
+            if (cgpa >= threshold) {
+                local.push_back(CohortEntry{i, cgpa});
+            }
+        }
+        std::lock_guard<std::mutex> guard(mergeLock);
+        result.insert(result.end(), local.begin(), local.end());
+    });
+    std::sort(result.begin(), result.end(), entryBefore);
+    return result;
+}
+/*
+ * Class: CgpaHistogram
+ * A mergeable sketch of a CGPA distribution – median, p90, buckets – built in a single pass.
+ * Since CGPAs live on a fixed 0–10 scale, plain fixed-width bins beat fancier sketches like t-digest: 1000 bins of
+ * 0.01 each means any quantile is off by at most one bin, adding a value is one increment, and merging two
+ * partial histograms from different workers is just adding the counts. Min, max and mean are tracked exactly.
+ * Anything outside 0–10 (say, from a hand-edited file) lands in the edge bins rather than getting dropped.
+ * NaN or infinite CGPAs can't go in any bin (and would poison the mean), so they're left out and just counted.
+ */
+class CgpaHistogram {
+private:
+    static constexpr size_t binCount = 1000;
+    static constexpr double scaleMax = 10.0;
+    std::vector<uint64_t> bins = std::vector<uint64_t>(binCount, 0);
+    uint64_t total = 0;
+    double sum = 0.0;
+    double minSeen = std::numeric_limits<double>::infinity();
+    double maxSeen = -std::numeric_limits<double>::infinity();
+    uint64_t nonFinite = 0;
+public:
+    void add(double cgpa) noexcept {
+        if (!std::isfinite(cgpa)) {
+            ++nonFinite;
+            return;
+        }
+        const double scaled = cgpa / scaleMax * binCount;
+        const size_t bin = scaled <= 0.0 ? 0 : std::min(binCount - 1, static_cast<size_t>(scaled));
+        ++bins[bin];
+        ++total;
+        sum += cgpa;
+        minSeen = std::min(minSeen, cgpa);
+        maxSeen = std::max(maxSeen, cgpa);
+    }
+    // Folds another worker's partial result into this one. Order doesn't matter.
+    void merge(const CgpaHistogram& other) noexcept {
+        for (size_t i = 0; i < binCount; ++i) {
+            bins[i] += other.bins[i];
+        }
+        total += other.total;
+        nonFinite += other.nonFinite;
+        sum += other.sum;
+        minSeen = std::min(minSeen, other.minSeen);
+        maxSeen = std::max(maxSeen, other.maxSeen);
+    }
+    uint64_t count() const noexcept { return total; }
+    // How many NaN/infinite values were left out of everything else.
+    uint64_t skipped() const noexcept { return nonFinite; }
+    double mean() const noexcept { return total == 0 ? 0.0 : sum / static_cast<double>(total); }
+    double min() const noexcept { return total == 0 ? 0.0 : minSeen; }
+    double max() const noexcept { return total == 0 ? 0.0 : maxSeen; }
+    // q in [0, 1], so 0.5 is the median and 0.9 is p90. Answers with the midpoint of the bin the rank falls in,
+    // clamped to the real min/max; p0 and p100 are the exact min and max.
+    double quantile(double q) const noexcept {
+        if (total == 0) {
+            return 0.0;
+        }
+        q = std::min(1.0, std::max(0.0, q));
+        const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * static_cast<double>(total))));
+        // The smallest and largest values are tracked exactly, so those two ranks don't need a bin at all.
+        if (rank == 1) {
+            return minSeen;
+        }
+        if (rank >= total) {
+            return maxSeen;
+        }
+        uint64_t seen = 0;
+        for (size_t i = 0; i < binCount; ++i) {
+            seen += bins[i];
+            if (seen >= rank) {
+                const double mid = (static_cast<double>(i) + 0.5) * scaleMax / binCount;
+                return std::min(maxSeen, std::max(minSeen, mid));
+            }
+        }
+        return maxSeen;
+    }
+    // Coarser report buckets over 0–10, e.g. 10 buckets gives counts for [0,1), [1,2), ... [9,10].
+    // bucketCount has to divide the 1000 fine bins evenly so no fine bin gets split.
+    std::vector<uint64_t> buckets(size_t bucketCount) const {
+        if (bucketCount == 0 || binCount % bucketCount != 0) {
+            throw std::invalid_argument("Bucket count must evenly divide 1000.");
+        }
+        std::vector<uint64_t> out(bucketCount, 0);
+        const size_t perBucket = binCount / bucketCount;
+        for (size_t i = 0; i < binCount; ++i) {
+            out[i / perBucket] += bins[i];
+        }
+        return out;
+    }
+};
+/*
+ * Function: cgpaStatistics
+ * Builds a CgpaHistogram over the whole cohort. Each worker fills its own histogram for its chunk, then
+ * merges it into the shared one under a lock – one merge per worker, not one per student.
+ */
+CgpaHistogram cgpaStatistics(const std::vector<Student>& cohort) {
+    CgpaHistogram combined;
+    std::mutex mergeLock;
+    parallelFor(cohort.size(), [&](size_t begin, size_t end) {
+        CgpaHistogram local;
+        for (size_t i = begin; i < end; ++i) {
+            local.add(cohort[i].calculateCGPA());
+        }
+        std::lock_guard<std::mutex> guard(mergeLock);
+        combined.merge(local);
+    });
+    return combined;
+}
+/*
+ * Struct: GroupTotals
+ * Credit and grade-point totals for one group, plus how many members (students or semesters) fed into it.
+ * Keeping raw totals instead of averages is what makes partial results safe to add together.
+ */
+struct GroupTotals {
+    double credits = 0.0;
+    double points = 0.0;
+    size_t members = 0;
+    double gpa() const noexcept { return credits == 0.0 ? 0.0 : points / credits; }
+};
+enum class GroupBy { Department, Batch, Term };
+/*
+ * Function: aggregateBy
+ * Per-department / per-batch / per-term totals and GPAs in one pass over the cohort.
+ * Each worker hashes into its own table so there's no contention while scanning, then the handful of
+ * per-worker tables get folded together at the end. Students (or semesters, for Term) with no key set
+ * end up under the empty string.
+ * For Department and Batch the members are students; for Term they're semesters.
+ */
+std::unordered_map<std::string, GroupTotals> aggregateBy(const std::vector<Student>& cohort, GroupBy key) {
+    std::unordered_map<std::string, GroupTotals> combined;
+    std::mutex mergeLock;
+    parallelFor(cohort.size(), [&](size_t begin, size_t end) {
+        std::unordered_map<std::string, GroupTotals> local;
+        for (size_t i = begin; i < end; ++i) {
+            const Student& st = cohort[i];
+            if (key == GroupBy::Term) {
+                for (const auto& sem : st.getSemesters()) {
+                    GroupTotals& g = local[sem.getTerm()];
+                    for (const auto& c : sem.getCourses()) {
+                        g.credits += c.credit;
+                        g.points += c.grade * c.credit;
+                    }
+                    ++g.members;
+                }
+            } else {
+                GroupTotals& g = local[key == GroupBy::Department ? st.getDepartment() : st.getBatch()];
+                g.credits += st.totalCredits();
+                g.points += st.totalPoints();
+                ++g.members;
+            }
+        }
+        std::lock_guard<std::mutex> guard(mergeLock);
+        for (const auto& entry : local) {
+            GroupTotals& g = combined[entry.first];
+            g.credits += entry.second.credits;
+            g.points += entry.second.points;
+            g.members += entry.second.members;
+        }
+    });
+    return combined;
+}
+/*
+ * Class: MpscQueue
+ * A lock-free multi-producer / single-consumer queue (the classic linked-list design with a stub node).
+ * Producers only ever do one atomic exchange on the head plus one store, so any number of threads can push
+ * without waiting on each other. Only one thread may pop. Pushes from the same thread come out in the same order.
+ */
+template <typename T>
+class MpscQueue {
+private:
+    struct Node {
+        std::atomic<Node*> next{nullptr};
+        T value;
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+    };
+    std::atomic<Node*> head;  // Where producers push.
+    Node* tail;               // Where the consumer pops; it always points at an already-consumed (or stub) node.
+public:
+    MpscQueue() : head(new Node()), tail(head.load()) {}
+    ~MpscQueue() {
+        while (tail != nullptr) {
+            Node* next = tail->next.load(std::memory_order_relaxed);
+            delete tail;
+            tail = next;
+        }
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Safe from any thread.
+    void push(T value) {
+        Node* node = new Node(std::move(value));
+        Node* prev = head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+    // Consumer thread only. Returns false if nothing is visible yet – a producer halfway through push()
+    // just shows up on the next call.
+    bool pop(T& out) {
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        out = std::move(next->value);
+        delete tail;
+        tail = next;
+        return true;
+    }
+};
+/*
+ * Class: CohortIngestor
+ * Lets lots of threads submit grades at once without the front-end serializing them.
+ * Semester::addCourse and Student::addSemester aren't thread-safe, so submitters never touch a Student directly –
+ * they validate and push a record onto a lock-free queue, and a single applier thread drains it in batches.
+ * Courses for a student pile up in an open semester on the applier side until closeSemester() is seen for that
+ * student; submitSemester() ships a whole semester in one go. Bad grades/credits are rejected at submit time
+ * with the usual exceptions, so the applier never has to deal with junk.
+ * The cohort vector itself mustn't be resized while an ingestor is bound to it.
+ */
+class CohortIngestor {
+private:
+    struct Record {
+        enum class Kind { Course, CloseSemester, WholeSemester } kind = Kind::Course;
+        size_t student = 0;
+        double grade = 0.0;
+        double credit = 0.0;
+        Semester semester;
+    };
+    std::vector<Student>& cohort;
+    MpscQueue<Record> queue;
+    std::unordered_map<size_t, Semester> openSemesters;  // Applier-side only, so no locking needed.
+
+    void checkStudent(size_t student) const {
+        if (student >= cohort.size()) {
+            throw std::out_of_range("Student index is outside the cohort.");
+        }
+    }
+public:
+    explicit CohortIngestor(std::vector<Student>& target) : cohort(target) {}
+
+    // The submit calls are safe from any number of threads.
+    void submitCourse(size_t student, double grade, double credit) {
+        checkStudent(student);
+        validateCourse(grade, credit);
+        Record r;
+        r.kind = Record::Kind::Course;
+        r.student = student;
+        r.grade = grade;
+        r.credit = credit;
+        queue.push(std::move(r));
+    }
+    void closeSemester(size_t student) {
+        checkStudent(student);
+        Record r;
+        r.kind = Record::Kind::CloseSemester;
+        r.student = student;
+        queue.push(std::move(r));
+    }
+    void submitSemester(size_t student, Semester sem) {
+        checkStudent(student);
+        for (const auto& c : sem.getCourses()) {
+            validateCourse(c.grade, c.credit);
+        }
+        Record r;
+        r.kind = Record::Kind::WholeSemester;
+        r.student = student;
+        r.semester = std::move(sem);
+        queue.push(std::move(r));
+    }
+    // Applier thread only. Drains everything currently queued into the Students and returns how many records it
+    // applied. Call it in a loop (or on a timer) – one call per batch is what keeps the per-record cost tiny.
+    size_t applyPending() {
+        size_t applied = 0;
+        Record r;
+        while (queue.pop(r)) {
+            switch (r.kind) {
+            case Record::Kind::Course:
+                openSemesters[r.student].addCourse(r.grade, r.credit);
+                break;
+            case Record::Kind::CloseSemester: {
+                auto it = openSemesters.find(r.student);
+                if (it != openSemesters.end()) {
+                    cohort[r.student].addSemester(std::move(it->second));
+                    openSemesters.erase(it);
+                }
+                break;
+            }
+            case Record::Kind::WholeSemester:
+                cohort[r.student].addSemester(std::move(r.semester));
+                r.semester = Semester();
+                break;
+            }
+            ++applied;
+        }
+        return applied;
+    }
+    // How many students still have courses waiting on a closeSemester().
+    size_t openSemesterCount() const noexcept { return openSemesters.size(); }
+};
+/*
+ * Class: VersionedStudent
+ * Read-copy-update wrapper so queries (calculateCGPA, displayAll) and updates (addSemester, loadFromFile) can overlap.
+ * Readers grab the current version as a shared_ptr<const Student> and work on it for as long as they like – it's
+ * immutable, and it stays alive until the last reader lets go, so there's no reclamation bookkeeping to do.
+ * Writers copy the current version, change the copy, and publish it with one atomic pointer swap. Writers are
+ * serialized among themselves by a mutex, but readers never wait on it, so read latency doesn't care how busy
+ * the writers are.
+ * With C++20's std::atomic<std::shared_ptr> the pointer is one of those; on C++17 it falls back to the
+ * std::atomic_load / std::atomic_store free functions (deprecated in C++20, hence the switch).
+ */
+class VersionedStudent {
+private:
+#if defined(__cpp_lib_atomic_shared_ptr)
+    std::atomic<std::shared_ptr<const Student>> current;
+    std::shared_ptr<const Student> loadCurrent() const noexcept { return current.load(); }
+    void storeCurrent(std::shared_ptr<const Student> next) noexcept { current.store(std::move(next)); }
+#else
+    std::shared_ptr<const Student> current;
+    std::shared_ptr<const Student> loadCurrent() const noexcept { return std::atomic_load(&current); }
+    void storeCurrent(std::shared_ptr<const Student> next) noexcept { std::atomic_store(&current, std::move(next)); }
+#endif
+    std::atomic<uint64_t> versionCounter{0};
+    std::mutex writerLock;
+public:
+    VersionedStudent() : current(std::make_shared<const Student>()) {}
+    explicit VersionedStudent(Student initial) : current(std::make_shared<const Student>(std::move(initial))) {}
+
+    // Never blocks on writers. Hang on to the pointer for a consistent view across several calls.
+    std::shared_ptr<const Student> snapshot() const noexcept {
+        return loadCurrent();
+    }
+    // Bumped once per published update – handy for "has anything changed since I last looked?".
+    uint64_t version() const noexcept { return versionCounter.load(std::memory_order_acquire); }
+    // Copy, modify, publish. If fn throws, nothing gets published and readers keep the old version.
+    template <typename Fn>
+    void update(Fn fn) {
+        std::lock_guard<std::mutex> guard(writerLock);
+        auto next = std::make_shared<Student>(*loadCurrent());
+        fn(*next);
+        storeCurrent(std::shared_ptr<const Student>(std::move(next)));
+        versionCounter.fetch_add(1, std::memory_order_release);
+    }
+    void addSemester(Semester sem) {
+        update([&sem](Student& st) { st.addSemester(std::move(sem)); });
+    }
+    // Returns false (and publishes nothing) if there's no file. Corrupt data throws out of update(), so readers
+    // keep the old version instead of getting an empty one.
+    bool loadFromFile(const std::string& path = "cgpa_data.txt") {
+        std::ifstream file(path);
+        if (!file) {
+            return false;
+        }
+        update([&file](Student& st) { st.readRecords(file); });
+        return true;
+    }
+};
+/*
+ * Class: StudentRegistry
+ * Holds many students keyed by student ID, split into shards so one global lock doesn't serialize everything.
+ * The ID's hash picks the shard; each shard has its own map and its own reader/writer lock, so updates to different
+ * students almost never touch the same lock, and queries on the same shard can run side by side.
+ * The shard count gets rounded up to a power of two so picking a shard is a mask, not a division.
+ * Anything that needs to touch a student goes through withStudent()/readStudent(), which hold the shard lock
+ * only for the duration of the callback – don't hang onto references past that.
+ */
+class StudentRegistry {
+private:
+    struct Shard {
+        mutable std::shared_mutex lock;
+        std::unordered_map<std::string, Student> students;
+    };
+    std::vector<std::unique_ptr<Shard>> shards;
+    size_t shardMask;
+
+    Shard& shardFor(const std::string& id) const noexcept {
+        return *shards[std::hash<std::string>{}(id) & shardMask];
+    }
+public:
+    explicit StudentRegistry(size_t shardCount = 4 * std::max<size_t>(1, std::thread::hardware_concurrency())) {
+        size_t rounded = 1;
+        while (rounded < shardCount) {
+            rounded <<= 1;
+        }
+        shardMask = rounded - 1;
+        for (size_t i = 0; i < rounded; ++i) {
+            shards.push_back(std::make_unique<Shard>());
+        }
+    }
+    size_t shardCount() const noexcept { return shards.size(); }
+    // Runs fn(Student&) under the shard's exclusive lock, creating the student if it isn't there yet.
+    template <typename Fn>
+    auto withStudent(const std::string& id, Fn fn) {
+        Shard& shard = shardFor(id);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        return fn(shard.students[id]);
+    }
+    // Runs fn(const Student&) under a shared lock. Throws std::out_of_range for an unknown ID.
+    template <typename Fn>
+    auto readStudent(const std::string& id, Fn fn) const {
+        const Shard& shard = shardFor(id);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        auto it = shard.students.find(id);
+        if (it == shard.students.end()) {
+            throw std::out_of_range("Unknown student ID: " + id);
+        }
+        return fn(it->second);
+    }
+    void addSemester(const std::string& id, Semester sem) {
+        withStudent(id, [&sem](Student& st) { st.addSemester(std::move(sem)); });
+    }
+    double calculateCGPA(const std::string& id) const {
+        return readStudent(id, [](const Student& st) { return st.calculateCGPA(); });
+    }
+    bool contains(const std::string& id) const {
+        const Shard& shard = shardFor(id);
+        std::shared_lock<std::shared_mutex> guard(shard.lock);
+        return shard.students.count(id) != 0;
+    }
+    bool remove(const std::string& id) {
+        Shard& shard = shardFor(id);
+        std::unique_lock<std::shared_mutex> guard(shard.lock);
+        return shard.students.erase(id) != 0;
+    }
+    size_t size() const {
+        size_t total = 0;
+        for (const auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            total += shard->students.size();
+        }
+        return total;
+    }
+    // Visits every student, one shard per task on the shared scheduler, under that shard's shared lock.
+    // fn(id, student) may be called from several threads at once.
+    template <typename Fn>
+    void forEach(Fn fn) const {
+        parallelFor(shards.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                std::shared_lock<std::shared_mutex> guard(shards[i]->lock);
+                for (const auto& entry : shards[i]->students) {
+                    fn(entry.first, entry.second);
+                }
+            }
+        });
+    }
+    // Same visit, but one shard after another on the calling thread – for writers that feed a single stream.
+    template <typename Fn>
+    void forEachSerial(Fn fn) const {
+        for (const auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            for (const auto& entry : shard->students) {
+                fn(entry.first, entry.second);
+            }
+        }
+    }
+    // Copies everyone out into a plain cohort vector (with matching IDs) so the ranking/statistics tools can run
+    // on it without holding any registry locks. Order follows shard order, not ID order.
+    std::vector<Student> exportCohort(std::vector<std::string>& ids) const {
+        std::vector<Student> cohort;
+        ids.clear();
+        for (const auto& shard : shards) {
+            std::shared_lock<std::shared_mutex> guard(shard->lock);
+            for (const auto& entry : shard->students) {
+                ids.push_back(entry.first);
+                cohort.push_back(entry.second);
+            }
+        }
+        return cohort;
+    }
+};
+/*
+ * Class: JsonWriter
+ * Bare-bones streaming JSON output for results. Everything goes through one fixed 16 KiB buffer that's handed to
+ * the stream in big writes; numbers get formatted right into it with std::to_chars (shortest text that reads back
+ * to the same double) and strings are escaped on the way in, so no std::string is ever built along the way.
+ * It doesn't keep track of nesting or commas – the writers below know their own shape.
+ */
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& o) : out(o) {}
+    ~JsonWriter() { flush(); }
+    JsonWriter(const JsonWriter&) = delete;
+    JsonWriter& operator=(const JsonWriter&) = delete;
+    // Punctuation and keys, copied as-is.
+    JsonWriter& raw(std::string_view text) {
+        if (used + text.size() > sizeof buffer) {
+            flush();
+            if (text.size() > sizeof buffer) {
+                out.write(text.data(), static_cast<std::streamsize>(text.size()));
+                return *this;
+            }
+        }
+        std::memcpy(buffer + used, text.data(), text.size());
+        used += text.size();
+        return *this;
+    }
+    JsonWriter& number(double value) {
+        if (!std::isfinite(value)) {
+            return raw("null");  // JSON has no NaN or infinity.
+        }
+        make(32);
+#if defined(__cpp_lib_to_chars)
+        used = static_cast<size_t>(std::to_chars(buffer + used, buffer + sizeof buffer, value).ptr - buffer);
+#else
+        used += static_cast<size_t>(std::snprintf(buffer + used, 32, "%.17g", value));
+#endif
+        return *this;
+    }
+    JsonWriter& string(std::string_view text) {
+        static const char hex[] = "0123456789abcdef";
+        make(1);
+        buffer[used++] = '"';
+        for (char ch : text) {
+            make(6);
+            const auto u = static_cast<unsigned char>(ch);
+            if (ch == '"' || ch == '\\') {
+                buffer[used++] = '\\';
+                buffer[used++] = ch;
+            } else if (u < 0x20) {
+                std::memcpy(buffer + used, "\\u00", 4);
+                buffer[used + 4] = hex[u >> 4];
+                buffer[used + 5] = hex[u & 0xF];
+                used += 6;
+            } else {
+                buffer[used++] = ch;
+            }
+        }
+        make(1);
+        buffer[used++] = '"';
+        return *this;
+    }
+    void flush() {
+        out.write(buffer, static_cast<std::streamsize>(used));
+        used = 0;
+    }
+private:
+    // Makes sure n more bytes fit, writing out what's there if they don't.
+    void make(size_t n) {
+        if (used + n > sizeof buffer) {
+            flush();
+        }
+    }
+    std::ostream& out;
+    char buffer[1 << 14];
+    size_t used = 0;
+};
+/*
+ * Function: writeStudentJson
+ * One student as a JSON object: {"id":"s1","semesters":[{"term":"2024-Fall","gpa":8.5},...],"cgpa":8.1}.
+ * The "id" key is left out when there's no ID (the single-student --batch case). GPAs come straight off the
+ * semester views as they're written.
+ */
+void writeStudentJson(JsonWriter& json, const Student& student, std::string_view id = {}) {
+    json.raw("{");
+    if (!id.empty()) {
+        json.raw("\"id\":").string(id).raw(",");
+    }
+    json.raw("\"semesters\":[");
+    bool first = true;
+    for (const auto& sem : student.getSemesters()) {
+        json.raw(first ? "{\"term\":" : ",{\"term\":").string(sem.getTerm()).raw(",\"gpa\":");
+        json.number(sem.calculateGPA()).raw("}");
+        first = false;
+    }
+    json.raw("],\"cgpa\":").number(student.calculateCGPA()).raw("}");
+}
+void writeStudentJson(std::ostream& out, const Student& student, std::string_view id = {}) {
+    JsonWriter json(out);
+    writeStudentJson(json, student, id);
+    json.raw("\n");
+}
+/*
+ * Function: writeCohortJson / writeCohortNdjson
+ * Everybody in the registry, keyed by their registry IDs – as one JSON array, or as NDJSON (one object per line,
+ * easy to stream into other tools). Students are written shard by shard under each shard's read lock, in shard
+ * order rather than ID order.
+ */
+void writeCohortJson(std::ostream& out, const StudentRegistry& registry) {
+    JsonWriter json(out);
+    json.raw("[");
+    bool first = true;
+    registry.forEachSerial([&](const std::string& id, const Student& student) {
+        json.raw(first ? "\n" : ",\n");
+        writeStudentJson(json, student, id);
+        first = false;
+    });
+    json.raw(first ? "]\n" : "\n]\n");
+}
+void writeCohortNdjson(std::ostream& out, const StudentRegistry& registry) {
+    JsonWriter json(out);
+    registry.forEachSerial([&json](const std::string& id, const Student& student) {
+        writeStudentJson(json, student, id);
+        json.raw("\n");
+    });
+}
+/*
+ * Columnar export
+ * Cohort results laid out column by column for analytics tools, Arrow-style: each column is a couple of flat,
+ * 8-byte-aligned buffers (offsets and values, no per-row framing at all), so a reader can point an array straight
+ * at them. It isn't real Arrow IPC or Parquet – both need flatbuffers/thrift metadata and a library to go with
+ * it – but the buffers match Arrow's LargeUtf8, Float64 and LargeList<Float64> layouts one-for-one, so a
+ * twenty-line reader can hand them to pyarrow or pandas without copying.
+ * File layout (in the writer's byte order; the 0x01020304 mark tells a reader which one that was):
+ *   header:     "CGPACOL1"  uint32 byteOrderMark  uint32 columnCount  uint64 rowCount
+ *   per column: char name[16]  uint32 type  uint32 bufferCount, then per buffer uint64 byteLength + the bytes,
+ *               zero-padded to a multiple of 8
+ *   footer:     uint64 columnOffset[columnCount]  uint64 columnCount  "CGPACOL1"
+ * Types: 1 = utf8 (int64 offsets[rows + 1], bytes), 2 = float64 (values[rows]),
+ *        3 = list<float64> (int64 offsets[rows + 1], float64 values[all semesters]).
+ * Columns: student_id (utf8), semester_gpa (list<float64>), cgpa (float64).
+ */
+enum class ColumnType : uint32_t { Utf8 = 1, Float64 = 2, ListFloat64 = 3 };
+/*
+ * Class: ColumnarCohort
+ * Collects students straight into the column buffers – add() just appends to a handful of flat vectors – and
+ * write() puts each buffer out with a single write, so nothing is formatted row by row.
+ */
+class ColumnarCohort {
+public:
+    void reserve(size_t students) {
+        idOffsets.reserve(students + 1);
+        gpaOffsets.reserve(students + 1);
+        cgpas.reserve(students);
+    }
+    void add(std::string_view id, const Student& student) {
+        idBytes.insert(idBytes.end(), id.begin(), id.end());
+        idOffsets.push_back(static_cast<int64_t>(idBytes.size()));
+        for (const auto& sem : student.getSemesters()) {
+            gpas.push_back(sem.calculateGPA());
+        }
+        gpaOffsets.push_back(static_cast<int64_t>(gpas.size()));
+        cgpas.push_back(student.calculateCGPA());
+    }
+    size_t size() const noexcept { return cgpas.size(); }
+    // Writes the whole file. Throws std::runtime_error if the stream gives up partway.
+    void write(std::ostream& out) const {
+        static const char magic[8] = {'C', 'G', 'P', 'A', 'C', 'O', 'L', '1'};
+        uint64_t position = 0;
+        auto put = [&out, &position](const void* data, size_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            position += bytes;
+        };
+        auto putBuffer = [&put, &position](const void* data, size_t bytes) {
+            static const char zeros[8] = {};
+            const uint64_t length = bytes;
+            put(&length, sizeof length);
+            put(data, bytes);
+            put(zeros, (8 - position % 8) % 8);
+        };
+        std::vector<uint64_t> columnOffsets;
+        auto putColumn = [&](const char* name, ColumnType type,
+                             std::initializer_list<std::pair<const void*, size_t>> buffers) {
+            columnOffsets.push_back(position);
+            char paddedName[16] = {};
+            std::memcpy(paddedName, name, std::min(sizeof paddedName, std::strlen(name)));
+            const uint32_t typeCode = static_cast<uint32_t>(type);
+            const uint32_t bufferCount = static_cast<uint32_t>(buffers.size());
+            put(paddedName, sizeof paddedName);
+            put(&typeCode, sizeof typeCode);
+            put(&bufferCount, sizeof bufferCount);
+            for (const auto& buffer : buffers) {
+                putBuffer(buffer.first, buffer.second);
+            }
+        };
+        const uint32_t byteOrderMark = 0x01020304;
+        const uint32_t columnCount = 3;
+        const uint64_t rowCount = size();
+        put(magic, sizeof magic);
+        put(&byteOrderMark, sizeof byteOrderMark);
+        put(&columnCount, sizeof columnCount);
+        put(&rowCount, sizeof rowCount);
+        putColumn("student_id", ColumnType::Utf8,
+                  {{idOffsets.data(), idOffsets.size() * sizeof(int64_t)}, {idBytes.data(), idBytes.size()}});
+        putColumn("semester_gpa", ColumnType::ListFloat64,
+                  {{gpaOffsets.data(), gpaOffsets.size() * sizeof(int64_t)},
+                   {gpas.data(), gpas.size() * sizeof(double)}});
+        putColumn("cgpa", ColumnType::Float64, {{cgpas.data(), cgpas.size() * sizeof(double)}});
+        const uint64_t footerCount = columnOffsets.size();
+        put(columnOffsets.data(), columnOffsets.size() * sizeof(uint64_t));
+        put(&footerCount, sizeof footerCount);
+        put(magic, sizeof magic);
+        out.flush();
+        if (!out) {
+            throw std::runtime_error("Failed to write columnar file.");
+        }
+    }
+private:
+    std::vector<char> idBytes;
+    std::vector<int64_t> idOffsets{0};
+    std::vector<int64_t> gpaOffsets{0};
+    std::vector<double> gpas;
+    std::vector<double> cgpas;
+};
+/*
+ * Function: writeCohortColumnarFile
+ * Everybody in the registry as one columnar file (shard order, like the JSON writers). Goes through a temp file
+ * and a rename, so readers never see half a file. Throws if it can't be written.
+ */
+void writeCohortColumnarFile(const std::string& path, const StudentRegistry& registry) {
+    ColumnarCohort columns;
+    columns.reserve(registry.size());
+    registry.forEachSerial([&columns](const std::string& id, const Student& student) { columns.add(id, student); });
+    const std::string temp = path + ".tmp";
+    try {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Failed to open columnar file for writing.");
+        }
+        columns.write(file);
+    } catch (...) {
+        std::remove(temp.c_str());  // Don't leave a half-written temp file lying around.
+        throw;
+    }
+    if (!replaceFile(temp, path)) {
+        std::remove(temp.c_str());
+        throw std::runtime_error("Failed to move columnar file into place.");
+    }
+}
+#ifdef CGPA_HAVE_COROUTINES
+/*
+ * Class: Task
+ * A lazy C++20 coroutine task for the async load/save/compute API (only compiled when building with -std=c++20;
+ * the C++17 build doesn't see any of this). Nothing runs until the task is awaited, start()ed or get()ed.
+ * Awaiting it from another coroutine chains the two together with no blocking; get() is the bridge back to plain
+ * code and blocks until the result is in. Exceptions thrown inside come back out of co_await / get().
+ */
+template <typename T>
+class Task;
+template <typename T>
+struct TaskPromiseBase {
+    std::exception_ptr error;
+    std::coroutine_handle<> continuation;
+    // Lives outside the frame, shared with the Task: once get()/~Task sees it flip, the frame can be destroyed
+    // straight away, so the finishing side mustn't touch anything in the frame after the store.
+    std::shared_ptr<std::atomic<bool>> finished = std::make_shared<std::atomic<bool>>(false);
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    // On completion, hand control straight to whoever was awaiting (symmetric transfer), or flag get() if nobody is.
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename Promise>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> h) noexcept {
+            auto& promise = h.promise();
+            std::coroutine_handle<> next = promise.continuation;
+            const std::shared_ptr<std::atomic<bool>> flag = promise.finished;  // Our own reference, off the frame.
+            flag->store(true, std::memory_order_release);
+            flag->notify_all();
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+template <typename T>
+struct TaskPromise : TaskPromiseBase<T> {
+    std::optional<T> value;
+    Task<T> get_return_object() noexcept;
+    void return_value(T v) { value = std::move(v); }
+    T take() {
+        if (this->error) {
+            std::rethrow_exception(this->error);
+        }
+        return std::move(*value);
+    }
+};
+template <>
+struct TaskPromise<void> : TaskPromiseBase<void> {
+    Task<void> get_return_object() noexcept;
+    void return_void() noexcept {}
+    void take() {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+};
+template <typename T>
+class Task {
+public:
+    using promise_type = TaskPromise<T>;
+private:
+    std::coroutine_handle<promise_type> handle;
+    std::shared_ptr<std::atomic<bool>> finished;
+    bool started = false;
+public:
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle(h), finished(h.promise().finished) {}
+    Task(Task&& other) noexcept
+        : handle(std::exchange(other.handle, nullptr)), finished(std::move(other.finished)), started(other.started) {}
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() {
+        if (handle) {
+            // A started task may still be running on the pool; let it finish before its frame goes away.
+            if (started) {
+                finished->wait(false, std::memory_order_acquire);
+            }
+            handle.destroy();
+        }
+    }
+    // Kicks the task off without waiting, so lots of them can be in flight at once.
+    void start() {
+        if (!started) {
+            started = true;
+            handle.resume();
+        }
+    }
+    // Blocks the calling (non-coroutine) thread until the task is done.
+    T get() {
+        start();
+        finished->wait(false, std::memory_order_acquire);
+        return handle.promise().take();
+    }
+    // co_await support: park the awaiting coroutine as our continuation and jump straight into this task.
+    bool await_ready() const noexcept { return false; }
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        started = true;
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+    T await_resume() { return handle.promise().take(); }
+};
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>(std::coroutine_handle<TaskPromise<T>>::from_promise(*this));
+}
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>(std::coroutine_handle<TaskPromise<void>>::from_promise(*this));
+}
+/*
+ * Struct: ResumeOnPool
+ * co_await ResumeOnPool{} moves the rest of the coroutine onto the shared scheduler, which is how the async
+ * versions below get their blocking file I/O off the caller's thread.
+ */
+struct ResumeOnPool {
+    TaskScheduler& pool = sharedScheduler();
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> h) { pool.submit([h]() { h.resume(); }); }
+    void await_resume() const noexcept {}
+};
+/*
+ * Async Student API
+ * Awaitable versions of calculateCGPA / saveToFile / loadFromFile. Each hops onto the pool and then does the
+ * blocking work there, so a service can have hundreds of students' loads and saves in flight across a few threads
+ * while it keeps computing. The Student has to outlive the task, and one student shouldn't have two tasks running
+ * on it at once.
+ * Unlike the menu versions these don't print anything or swallow errors: a missing file, a failed write or
+ * corrupt data comes back out of co_await / get() as an exception. A failed load leaves the student untouched.
+ */
+Task<double> calculateCGPAAsync(const Student& student) {
+    co_await ResumeOnPool{};
+    co_return student.calculateCGPA();
+}
+Task<void> saveToFileAsync(const Student& student, std::string path) {
+    co_await ResumeOnPool{};
+    CGPA_TIME_SCOPE(Probe::SaveToFile);
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Failed to open file for saving.");
+    }
+    student.writeRecords(file);
+    if (!file) {
+        throw std::runtime_error("Failed to write " + path + ".");
+    }
+    Instrumentation::instance().count(Counter::Saves);
+}
+Task<void> loadFromFileAsync(Student& student, std::string path) {
+    co_await ResumeOnPool{};
+    CGPA_TIME_SCOPE(Probe::LoadFromFile);
+    std::ifstream file(path);
+    if (!file) {
+        throw std::runtime_error("No saved data found at " + path + ".");
+    }
+    Student loaded;
+    loaded.readRecords(file);
+    student = std::move(loaded);
+}
+// Starts every task, then collects the results in order – the simple way to get a whole batch in flight.
+template <typename T>
+std::vector<T> runAll(std::vector<Task<T>>& tasks) {
+    for (auto& t : tasks) {
+        t.start();
+    }
+    std::vector<T> results;
+    results.reserve(tasks.size());
+    for (auto& t : tasks) {
+        results.push_back(t.get());
+    }
+    return results;
+}
+inline void runAll(std::vector<Task<void>>& tasks) {
+    for (auto& t : tasks) {
+        t.start();
+    }
+    for (auto& t : tasks) {
+        t.get();
+    }
+}
+#endif
+/*
+ * Struct: BulkLoadResult
+ * What a bulk load hands back: one Student per path (same order), plus the indices of paths that couldn't be
+ * opened or held corrupt data. Those students are left empty.
+ */
+struct BulkLoadResult {
+    std::vector<Student> students;
+    std::vector<size_t> failed;
+};
+/*
+ * Function: loadStudentFilesPortable
+ * Plain ifstream-per-file bulk load spread over the scheduler. It's the fallback when io_uring isn't there.
+ */
+BulkLoadResult loadStudentFilesPortable(const std::vector<std::string>& paths) {
+    BulkLoadResult result;
+    result.students.resize(paths.size());
+    std::vector<char> ok(paths.size(), 0);
+    parallelFor(paths.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            std::ifstream file(paths[i]);
+            if (!file) {
+                continue;
+            }
+            try {
+                result.students[i].readRecords(file);
+                ok[i] = 1;
+            } catch (const std::exception&) {
+                result.students[i] = Student();
+            }
+        }
+    });
+    for (size_t i = 0; i < paths.size(); ++i) {
+        if (!ok[i]) {
+            result.failed.push_back(i);
+        }
+    }
+    return result;
+}
+#ifdef CGPA_HAVE_IO_URING
+/*
+ * Class: IoUring
+ * Bare-bones RAII wrapper over the io_uring syscalls – just enough rings plumbing for the bulk loader.
+ * Queue an SQE with nextSqe(), fill it in, and submitAndWait() pushes everything queued in one syscall.
+ * Throws if the kernel won't give us a ring (too old, or blocked by a sandbox); the caller falls back then.
+ */
+class IoUring {
+private:
+    int ringFd = -1;
+    void* sqRing = MAP_FAILED;
+    void* cqRing = MAP_FAILED;
+    size_t sqRingSize = 0, cqRingSize = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+    size_t sqesSize = 0;
+    unsigned *sqHead, *sqTail, *sqMask, *sqArray;
+    unsigned *cqHead, *cqTail, *cqMask;
+    io_uring_cqe* cqes;
+    unsigned sqEntries = 0;
+    unsigned localTail = 0;     // Our copy of the SQ tail; published to the kernel in submitAndWait.
+    unsigned unsubmitted = 0;
+
+    static unsigned* at(void* base, unsigned offset) {
+        return reinterpret_cast<unsigned*>(static_cast<char*>(base) + offset);
+    }
+public:
+    explicit IoUring(unsigned entries) {
+        io_uring_params params{};
+        ringFd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (ringFd < 0) {
+            throw std::runtime_error("io_uring is not available.");
+        }
+        sqEntries = params.sq_entries;
+        sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        const bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (singleMmap) {
+            sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+        }
+        sqRing = ::mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+        cqRing = singleMmap ? sqRing
+                            : ::mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd,
+                                     IORING_OFF_CQ_RING);
+        sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        sqes = static_cast<io_uring_sqe*>(
+            ::mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES));
+        if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqes == MAP_FAILED) {
+            release();
+            throw std::runtime_error("Failed to map io_uring rings.");
+        }
+        sqHead = at(sqRing, params.sq_off.head);
+        sqTail = at(sqRing, params.sq_off.tail);
+        sqMask = at(sqRing, params.sq_off.ring_mask);
+        sqArray = at(sqRing, params.sq_off.array);
+        cqHead = at(cqRing, params.cq_off.head);
+        cqTail = at(cqRing, params.cq_off.tail);
+        cqMask = at(cqRing, params.cq_off.ring_mask);
+        cqes = reinterpret_cast<io_uring_cqe*>(static_cast<char*>(cqRing) + params.cq_off.cqes);
+        localTail = *sqTail;
+    }
+    ~IoUring() { release(); }
+    IoUring(const IoUring&) = delete;
+    IoUring& operator=(const IoUring&) = delete;
+
+    void release() noexcept {
+        if (sqes != MAP_FAILED) {
+            ::munmap(sqes, sqesSize);
+            sqes = static_cast<io_uring_sqe*>(MAP_FAILED);
+        }
+        if (cqRing != MAP_FAILED && cqRing != sqRing) {
+            ::munmap(cqRing, cqRingSize);
+        }
+        cqRing = MAP_FAILED;
+        if (sqRing != MAP_FAILED) {
+            ::munmap(sqRing, sqRingSize);
+            sqRing = MAP_FAILED;
+        }
+        if (ringFd >= 0) {
+            ::close(ringFd);
+            ringFd = -1;
+        }
+    }
+    unsigned capacity() const noexcept { return sqEntries; }
+    // A zeroed SQE to fill in, or nullptr if the submission queue is full.
+    io_uring_sqe* nextSqe() noexcept {
+        const unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+        if (localTail - head >= sqEntries) {
+            return nullptr;
+        }
+        const unsigned index = localTail & *sqMask;
+        io_uring_sqe* sqe = &sqes[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        sqArray[index] = index;
+        ++localTail;
+        ++unsubmitted;
+        return sqe;
+    }
+    // Hands every queued SQE to the kernel and waits until at least minComplete completions are ready.
+    void submitAndWait(unsigned minComplete) {
+        __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+        while (true) {
+            const long rc = ::syscall(__NR_io_uring_enter, ringFd, unsubmitted, minComplete, IORING_ENTER_GETEVENTS,
+                                      nullptr, 0);
+            if (rc >= 0) {
+                unsubmitted -= static_cast<unsigned>(rc);
+                return;
+            }
+            if (errno != EINTR) {
+                throw std::runtime_error("io_uring_enter failed.");
+            }
+        }
+    }
+    // Calls fn(user_data, res) for every completion that's ready, then releases them back to the kernel.
+    template <typename Fn>
+    void drainCompletions(Fn fn) {
+        unsigned head = *cqHead;
+        const unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes[head & *cqMask];
+            fn(cqe.user_data, cqe.res);
+            ++head;
+        }
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+};
+/*
+ * Function: loadStudentFilesUring
+ * Bulk-loads one saved-data file per student through io_uring: opens, reads and closes all go through the ring
+ * in big batches, so hundreds of files cost a handful of syscalls instead of an open/read/close trio each.
+ * Every file moves through open -> read (repeated, doubling the buffer, until a short read) -> close, with one
+ * request in flight per file and up to the ring's capacity of files at once. As soon as a file's bytes are in,
+ * parsing goes off to the scheduler while the ring keeps working on the rest.
+ * Needs kernel 5.6+ for the open/read/close opcodes; files that come back -EINVAL (older kernel) get retried the
+ * portable way.
+ */
+BulkLoadResult loadStudentFilesUring(const std::vector<std::string>& paths, IoUring& ring) {
+    enum Stage : uint64_t { Open = 0, Read = 1, Close = 2 };
+    struct FileState {
+        int fd = -1;
+        std::vector<char> buffer;
+        size_t filled = 0;
+    };
+    const size_t n = paths.size();
+    BulkLoadResult result;
+    result.students.resize(n);
+    std::vector<FileState> files(n);
+    std::vector<char> ok(n, 0);
+    std::vector<size_t> retry;
+    const size_t initialBuffer = 16 * 1024;
+    auto queue = [&](size_t i, Stage stage) {
+        io_uring_sqe* sqe = ring.nextSqe();  // Never null: each active file has at most one request in the ring.
+        sqe->user_data = (static_cast<uint64_t>(i) << 2) | stage;
+        FileState& f = files[i];
+        if (stage == Open) {
+            sqe->opcode = IORING_OP_OPENAT;
+            sqe->fd = AT_FDCWD;
+            sqe->addr = reinterpret_cast<uint64_t>(paths[i].c_str());
+            sqe->open_flags = O_RDONLY | O_CLOEXEC;
+        } else if (stage == Read) {
+            sqe->opcode = IORING_OP_READ;
+            sqe->fd = f.fd;
+            sqe->addr = reinterpret_cast<uint64_t>(f.buffer.data() + f.filled);
+            sqe->len = static_cast<uint32_t>(f.buffer.size() - f.filled);
+            sqe->off = f.filled;
+        } else {
+            sqe->opcode = IORING_OP_CLOSE;
+            sqe->fd = f.fd;
+        }
+    };
+    TaskGroup parsers;
+    size_t nextFile = 0, active = 0;
+    const size_t window = ring.capacity();
+    while (nextFile < n || active > 0) {
+        while (active < window && nextFile < n) {
+            queue(nextFile++, Open);
+            ++active;
+        }
+        ring.submitAndWait(1);
+        ring.drainCompletions([&](uint64_t userData, int res) {
+            const size_t i = static_cast<size_t>(userData >> 2);
+            const auto stage = static_cast<Stage>(userData & 3);
+            FileState& f = files[i];
+            if (stage == Open) {
+                if (res < 0) {
+                    if (res == -EINVAL) {
+                        retry.push_back(i);
+                    }
+                    --active;
+                    return;
+                }
+                f.fd = res;
+                f.buffer.resize(initialBuffer);
+                queue(i, Read);
+            } else if (stage == Read) {
+                if (res < 0) {
+                    f.buffer.clear();
+                    queue(i, Close);
+                    return;
+                }
+                f.filled += static_cast<size_t>(res);
+                if (res > 0 && f.filled == f.buffer.size()) {
+                    f.buffer.resize(f.buffer.size() * 2);  // Might be more – grow and keep reading.
+                    queue(i, Read);
+                    return;
+                }
+                queue(i, Close);
+                parsers.run([&result, &ok, &f, i]() {
+                    try {
+                        result.students[i].readRecords(f.buffer.data(), f.filled);
+                        ok[i] = 1;
+                    } catch (const std::exception&) {
+                        result.students[i] = Student();
+                    }
+                    std::vector<char>().swap(f.buffer);
+                });
+            } else {
+                --active;
+            }
+        });
+    }
+    parsers.wait();
+    if (!retry.empty()) {
+        std::vector<std::string> retryPaths;
+        for (size_t i : retry) {
+            retryPaths.push_back(paths[i]);
+        }
+        BulkLoadResult second = loadStudentFilesPortable(retryPaths);
+        std::vector<char> secondFailed(retry.size(), 0);
+        for (size_t j : second.failed) {
+            secondFailed[j] = 1;
+        }
+        for (size_t j = 0; j < retry.size(); ++j) {
+            result.students[retry[j]] = std::move(second.students[j]);
+            ok[retry[j]] = !secondFailed[j];
+        }
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (!ok[i]) {
+            result.failed.push_back(i);
+        }
+    }
+    return result;
+}
+#endif
+/*
+ * Function: loadStudentFiles
+ * Loads a whole archive of per-student files (cgpa_data.txt format) in one call. Uses the io_uring path where the
+ * kernel allows it and quietly drops back to the portable loader where it doesn't.
+ */
+BulkLoadResult loadStudentFiles(const std::vector<std::string>& paths) {
+#ifdef CGPA_HAVE_IO_URING
+    try {
+        IoUring ring(256);
+        return loadStudentFilesUring(paths, ring);
+    } catch (const std::runtime_error&) {
+        // No usable ring here – fall through to the portable loader.
+    }
+#endif
+    return loadStudentFilesPortable(paths);
+}
+/*
+ * Struct: CsvImportResult
+ * What a CSV import reports back: rows that made it in, how many students and semesters they landed in, and the
+ * (1-based) line numbers of rows that got skipped for being malformed or out of range.
+ */
+struct CsvImportResult {
+    size_t rows = 0;
+    size_t students = 0;
+    size_t semesters = 0;
+    std::vector<size_t> badLines;
+};
+// One parsed CSV row. The views point into the import buffer, so rows are only good while that's alive.
+struct CsvRow {
+    std::string_view id;
+    std::string_view term;
+    double grade;
+    double credit;
+};
+/*
+ * Function: csvField
+ * Reads one field starting at p and leaves p on the comma (or end of line) after it. Blanks around the field are
+ * dropped, and so is one pair of double quotes, so quoted fields can hold commas. Doubled quotes inside a quoted
+ * field aren't unescaped – student IDs and term names don't have them.
+ */
+std::string_view csvField(const char*& p, const char* last) {
+    while (p < last && (*p == ' ' || *p == '\t')) {
+        ++p;
+    }
+    const char* start = p;
+    const char* stop;
+    if (p < last && *p == '"') {
+        start = ++p;
+        while (p < last && *p != '"') {
+            ++p;
+        }
+        stop = p;
+        while (p < last && *p != ',') {
+            ++p;
+        }
+    } else {
+        while (p < last && *p != ',') {
+            ++p;
+        }
+        stop = p;
+        while (stop > start && (stop[-1] == ' ' || stop[-1] == '\t')) {
+            --stop;
+        }
+    }
+    return std::string_view(start, static_cast<size_t>(stop - start));
+}
+/*
+ * Function: splitCsvRow
+ * Splits one line into exactly five fields – student_id, term, course, grade, credits. False if there are more
+ * or fewer.
+ */
+bool splitCsvRow(const char* first, const char* last, std::string_view (&fields)[5]) {
+    const char* p = first;
+    for (size_t k = 0; k < 5; ++k) {
+        if (k > 0) {
+            if (p == last) {
+                return false;
+            }
+            ++p;  // The comma.
+        }
+        fields[k] = csvField(p, last);
+    }
+    return p == last;
+}
+/*
+ * Function: parseCsvRow
+ * Splits a line with splitCsvRow and checks the course with validateCourse.
+ * The course name isn't kept: Course only has grade and credit. Returns false for anything that doesn't fit.
+ */
+bool parseCsvRow(const char* first, const char* last, CsvRow& row) {
+    std::string_view fields[5];
+    if (!splitCsvRow(first, last, fields) || fields[0].empty()) {
+        return false;
+    }
+    row.id = fields[0];
+    row.term = fields[1];
+    if (!parseNumber(fields[3].data(), fields[3].data() + fields[3].size(), row.grade) ||
+        !parseNumber(fields[4].data(), fields[4].data() + fields[4].size(), row.credit)) {
+        return false;
+    }
+    try {
+        validateCourse(row.grade, row.credit);
+    } catch (const std::runtime_error&) {
+        return false;  // A bad row is just skipped and counted by the importer, so no need to say why.
+    }
+    return true;
+}
+/*
+ * Function: isCsvHeader
+ * A header line has the five columns but words, not numbers, where the grade and credits go. A first line that's
+ * just a broken row (bad grade, missing column) doesn't count, so it gets reported like any other bad row.
+ */
+bool isCsvHeader(const char* first, const char* last) {
+    std::string_view fields[5];
+    if (!splitCsvRow(first, last, fields)) {
+        return false;
+    }
+    double number;
+    return !parseNumber(fields[3].data(), fields[3].data() + fields[3].size(), number) &&
+           !parseNumber(fields[4].data(), fields[4].data() + fields[4].size(), number);
+}
+/*
+ * Function: importCsv
+ * Bulk-imports an SIS export (student_id,term,course,grade,credits – one course per row) straight into the
+ * registry, no cgpa_data.txt detour. Three steps, each spread over the scheduler:
+ *   1. The buffer is cut into newline-aligned chunks that get parsed side by side. Every chunk drops its rows into
+ *      buckets picked by hashing the student ID, so all of one student's rows end up in the same bucket.
+ *   2. Each bucket is grouped on its own: rows are stably sorted by ID (so file order holds within a student),
+ *      and a student's rows become one semester per term, in the order the terms first show up.
+ *   3. Each student is written with one withStudent() call, building semesters in place – new semesters get added
+ *      after whatever the student already had.
+ * A header line is skipped if the first line looks like one (see isCsvHeader). Bad rows – including a bad first
+ * row in a header-less file – are skipped and reported, not fatal.
+ * Rows can end in \n or \r\n; quoted fields can't span lines.
+ */
+CsvImportResult importCsv(const char* data, size_t size, StudentRegistry& registry) {
+    CGPA_ALLOC_SCOPE(AllocTag::Ingest);
+    const char* const last = data + size;
+    const size_t chunkBytes = size_t{1} << 18;
+    const size_t chunkCount = std::max<size_t>(1, std::min(size / chunkBytes, sharedScheduler().workerCount() * 4));
+    const size_t bucketCount = chunkCount == 1 ? 1 : 64;
+    std::vector<const char*> cuts(chunkCount + 1, data);
+    cuts[chunkCount] = last;
+    for (size_t i = 1; i < chunkCount; ++i) {
+        const char* p = std::max(cuts[i - 1], data + size / chunkCount * i);
+        p = std::find(p, last, '\n');
+        cuts[i] = p == last ? last : p + 1;
+    }
+    struct Chunk {
+        std::vector<std::vector<CsvRow>> buckets;
+        std::vector<size_t> badLines;  // Relative to the chunk for now.
+        size_t lines = 0;
+    };
+    std::vector<Chunk> chunks(chunkCount);
+    {
+        TaskGroup group;
+        for (size_t c = 0; c < chunkCount; ++c) {
+            group.run([&, c]() {
+                Chunk& chunk = chunks[c];
+                chunk.buckets.resize(bucketCount);
+                const char* p = cuts[c];
+                const char* const stop = cuts[c + 1];
+                while (p < stop) {
+                    const char* eol = std::find(p, stop, '\n');
+                    const char* lineEnd = eol;
+                    if (lineEnd > p && lineEnd[-1] == '\r') {
+                        --lineEnd;
+                    }
+                    ++chunk.lines;
+                    if (std::find_if(p, lineEnd, [](char ch) { return ch != ' ' && ch != '\t'; }) != lineEnd) {
+                        CsvRow row;
+                        if (parseCsvRow(p, lineEnd, row)) {
+                            chunk.buckets[std::hash<std::string_view>{}(row.id) & (bucketCount - 1)].push_back(row);
+                        } else if (!(c == 0 && chunk.lines == 1 && isCsvHeader(p, lineEnd))) {
+                            chunk.badLines.push_back(chunk.lines);
+                        }
+                    }
+                    p = eol == stop ? stop : eol + 1;
+                }
+            });
+        }
+        group.wait();
+    }
+    CsvImportResult result;
+    size_t lineOffset = 0;
+    for (const Chunk& chunk : chunks) {
+        for (size_t line : chunk.badLines) {
+            result.badLines.push_back(lineOffset + line);
+        }
+        lineOffset += chunk.lines;
+    }
+    std::atomic<size_t> rows{0}, students{0}, semesters{0};
+    {
+        TaskGroup group;
+        for (size_t b = 0; b < bucketCount; ++b) {
+            group.run([&, b]() {
+                std::vector<const CsvRow*> bucket;
+                for (const Chunk& chunk : chunks) {
+                    for (const CsvRow& row : chunk.buckets[b]) {
+                        bucket.push_back(&row);
+                    }
+                }
+                std::stable_sort(bucket.begin(), bucket.end(),
+                                 [](const CsvRow* x, const CsvRow* y) { return x->id < y->id; });
+                std::vector<std::string_view> terms;
+                size_t localSemesters = 0, localStudents = 0;
+                for (size_t begin = 0; begin < bucket.size();) {
+                    size_t end = begin + 1;
+                    while (end < bucket.size() && bucket[end]->id == bucket[begin]->id) {
+                        ++end;
+                    }
+                    terms.clear();
+                    for (size_t i = begin; i < end; ++i) {
+                        if (std::find(terms.begin(), terms.end(), bucket[i]->term) == terms.end()) {
+                            terms.push_back(bucket[i]->term);
+                        }
+                    }
+                    registry.withStudent(std::string(bucket[begin]->id), [&](Student& st) {
+                        for (std::string_view term : terms) {
+                            SemesterBuilder sem = st.emplaceSemester();
+                            for (size_t i = begin; i < end; ++i) {
+                                if (bucket[i]->term == term) {
+                                    sem.addCourse(bucket[i]->grade, bucket[i]->credit);
+                                }
+                            }
+                            sem.commit(std::string(term));
+                        }
+                    });
+                    localSemesters += terms.size();
+                    ++localStudents;
+                    begin = end;
+                }
+                rows += bucket.size();
+                students += localStudents;
+                semesters += localSemesters;
+            });
+        }
+        group.wait();
+    }
+    result.rows = rows.load();
+    result.students = students.load();
+    result.semesters = semesters.load();
+    Instrumentation::instance().count(Counter::CoursesParsed, result.rows);
+    return result;
+}
+/*
+ * Function: importCsvFile
+ * importCsv for a file on disk: reads it in whole (one allocation) and imports from that. Throws if it can't open.
+ */
+CsvImportResult importCsvFile(const std::string& path, StudentRegistry& registry) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        throw std::runtime_error("Failed to open CSV file.");
+    }
+    std::string data(static_cast<size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(&data[0], static_cast<std::streamsize>(data.size()))) {
+        throw std::runtime_error("Failed to read CSV file.");
+    }
+    return importCsv(data.data(), data.size(), registry);
+}
 /*
  * Function: getValidatedInput
  * A handy template to grab and check user input for numbers.
- * Cuts down on repeating code. Throws or loops on bad input, and fixes the input stream so it doesn't get stuck.
- * Reusable for different types like int or double.
+ * Cuts down on repeating code. Loops on bad input, throwing away the rest of that line so it doesn't get stuck.
+ * Reusable for different types like int or double. Reads through the shared stdin tokenizer, so pasting a long
+ * run of answers in one go is fast too. Throws EndOfInputException if stdin runs dry instead of looping forever.
  * Ties into points: Used for inputting number of courses, grades, and credits with validation.
  */
 template <typename T>
 T getValidatedInput(const std::string& prompt, T minVal, T maxVal) {
+    InputTokenizer& input = stdinTokenizer();
     T value;
     while (true) {
-        std::cout << prompt;
-        if (std::cin >> value && value >= minVal && value <= maxVal) {
+        std::cout << prompt << std::flush;  // stdin isn't read through cin any more, so nothing flushes for us.
+        const TokenStatus status = input.next(value);
+        if (status == TokenStatus::End) {
+            throw EndOfInputException();
+        }
+        if (status == TokenStatus::Ok && value >= minVal && value <= maxVal) {
             return value;
-        } else {
-            std::cout << "Invalid input. Please try again." << std::endl;
-            std::cin.clear();  // Clear error flags.
-            std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n');  // Ignore bad input.
         }
+        std::cout << "Invalid input. Please try again." << std::endl;
+        input.discardLine();  // Ignore the rest of the bad line.
+    }
+}
+/*
+ * Function: parsePastedSemester
+ * Turns one pasted line like "8.5:4 7:3 9:2" into parallel grade and credit arrays (reused between calls).
+ * Parsing only checks the shape of each grade:credit pair; the ranges get checked afterwards in one branch-free
+ * sweep over the flat arrays, which the compiler can turn into SIMD compares. Only when that sweep finds something
+ * do we go back and work out which course it was, so a clean line never pays for the error reporting.
+ * Throws InvalidGradeException / InvalidCreditException / runtime_error naming the first bad course (1-based).
+ */
+void parsePastedSemester(const char* first, const char* last, std::vector<double>& grades,
+                         std::vector<double>& credits) {
+    grades.clear();
+    credits.clear();
+    const char* p = first;
+    while (true) {
+        while (p < last && std::isspace(static_cast<unsigned char>(*p))) {
+            ++p;
+        }
+        if (p == last) {
+            break;
+        }
+        const char* tokenEnd = p;
+        while (tokenEnd < last && !std::isspace(static_cast<unsigned char>(*tokenEnd))) {
+            ++tokenEnd;
+        }
+        const char* colon = std::find(p, tokenEnd, ':');
+        double g = 0.0, c = 0.0;
+        if (colon == tokenEnd || !parseNumber(p, colon, g) || !parseNumber(colon + 1, tokenEnd, c)) {
+            throw std::runtime_error("Course " + std::to_string(grades.size() + 1) +
+                                     " isn't a grade:credit pair.");
+        }
+        grades.push_back(g);
+        credits.push_back(c);
+        p = tokenEnd;
+    }
+    const size_t n = grades.size();
+    const double* gs = grades.data();
+    const double* cs = credits.data();
+    unsigned bad = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // NaN fails every comparison, so checking "in range" (not "out of range") catches it too.
+        bad |= static_cast<unsigned>(!(gs[i] >= minGrade) | !(gs[i] <= maxGrade) | !(cs[i] >= minCredit) |
+                                     !(cs[i] <= maxCredit));
+    }
+    if (!bad) {
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        try {
+            validateCourse(gs[i], cs[i]);
+        } catch (const InvalidGradeException& e) {
+            throw InvalidGradeException("Course " + std::to_string(i + 1) + ": " + e.what());
+        } catch (const InvalidCreditException& e) {
+            throw InvalidCreditException("Course " + std::to_string(i + 1) + ": " + e.what());
+        }
+    }
+}
+/*
+ * Function: pasteSemesters
+ * The bulk menu mode: every line is a whole semester of grade:credit pairs, and a blank line (or the end of
+ * input) finishes. A bad line gets reported and skipped without touching what's already been added – the rest
+ * still go in. Returns how many semesters were added.
+ */
+size_t pasteSemesters(Student& student, InputTokenizer& input) {
+    std::vector<double> grades, credits;
+    size_t added = 0;
+    size_t lineNo = 0;
+    const char* first;
+    const char* last;
+    while (input.nextLine(first, last)) {
+        ++lineNo;
+        try {
+            parsePastedSemester(first, last, grades, credits);
+        } catch (const std::exception& e) {
+            std::cout << "Line " << lineNo << " skipped: " << e.what() << std::endl;
+            continue;
+        }
+        if (grades.empty()) {
+            break;  // Blank line – we're done.
+        }
+        if (grades.size() > maxCoursesPerSemester) {
+            std::cout << "Line " << lineNo << " skipped: at most " << maxCoursesPerSemester
+                      << " courses per semester." << std::endl;
+            continue;
+        }
+        SemesterBuilder sem = student.emplaceSemester();
+        for (size_t i = 0; i < grades.size(); ++i) {
+            sem.addCourse(grades[i], credits[i]);
+        }
+        sem.commit();
+        ++added;
+    }
+    return added;
+}
+/*
+ * Wire protocol for server mode
+ * Small fixed-size binary frames, native byte order (client and server share the machine, so there's nothing to
+ * convert). A request is an 8-byte header, then the student ID bytes, then courseCount (grade, credit) pairs as
+ * doubles. Every request gets back exactly one 16-byte response, in order, so clients can pipeline freely.
+ *   Cgpa        – CGPA for the ID.
+ *   Gpa         – GPA for semester number semesterIndex (0-based) of the ID.
+ *   AddSemester – appends the attached courses as a new semester and answers with the new CGPA. Grades 0–10,
+ *                 credits 0.01–100 and at most 100 courses, or it's InvalidData.
+ */
+enum class WireOp : uint8_t { Cgpa = 1, Gpa = 2, AddSemester = 3 };
+enum class WireStatus : uint8_t { Ok = 0, UnknownStudent = 1, BadRequest = 2, InvalidData = 3 };
+struct WireRequestHeader {
+    uint8_t op;
+    uint8_t idLength;
+    uint16_t courseCount;
+    uint32_t semesterIndex;
+};
+struct WireResponse {
+    uint8_t status;
+    uint8_t reserved[7];
+    double value;
+};
+static_assert(sizeof(WireRequestHeader) == 8 && sizeof(WireResponse) == 16, "Wire frames must stay packed.");
+struct WireRequest {
+    WireRequestHeader header;
+    std::string id;
+    std::vector<Course> courses;
+};
+/*
+ * Function: decodeWireRequest
+ * Pulls one complete request off the front of a byte buffer. Returns false (and consumes nothing) if the
+ * frame isn't all there yet, so callers can just keep appending reads and trying again.
+ */
+bool decodeWireRequest(const char* data, size_t size, size_t& consumed, WireRequest& out) {
+    if (size < sizeof(WireRequestHeader)) {
+        return false;
+    }
+    std::memcpy(&out.header, data, sizeof(WireRequestHeader));
+    const size_t idBytes = out.header.idLength;
+    const size_t frame = sizeof(WireRequestHeader) + idBytes + size_t{out.header.courseCount} * 2 * sizeof(double);
+    if (size < frame) {
+        return false;
+    }
+    const char* cursor = data + sizeof(WireRequestHeader);
+    out.id.assign(cursor, idBytes);
+    cursor += idBytes;
+    out.courses.clear();
+    out.courses.reserve(out.header.courseCount);
+    for (uint16_t i = 0; i < out.header.courseCount; ++i) {
+        double pair[2];
+        std::memcpy(pair, cursor, sizeof(pair));
+        cursor += sizeof(pair);
+        out.courses.emplace_back(pair[0], pair[1]);
+    }
+    consumed = frame;
+    return true;
+}
+/*
+ * Function: handleWireRequest
+ * Runs one decoded request against the registry. Never throws – every failure maps onto a status code,
+ * because one bad request shouldn't take the connection (or the server) down.
+ */
+WireResponse handleWireRequest(StudentRegistry& registry, const WireRequest& req) {
+    WireResponse resp{};
+    resp.status = static_cast<uint8_t>(WireStatus::Ok);
+    try {
+        switch (static_cast<WireOp>(req.header.op)) {
+        case WireOp::Cgpa:
+            resp.value = registry.calculateCGPA(req.id);
+            break;
+        case WireOp::Gpa: {
+            const size_t index = req.header.semesterIndex;
+            resp.value = registry.readStudent(req.id, [index](const Student& st) {
+                const auto& sems = st.getSemesters();
+                if (index >= sems.size()) {
+                    throw std::invalid_argument("No such semester.");
+                }
+                return sems[index].calculateGPA();
+            });
+            break;
+        }
+        case WireOp::AddSemester: {
+            if (req.courses.empty()) {
+                throw std::invalid_argument("A semester needs at least one course.");
+            }
+            if (req.courses.size() > maxCoursesPerSemester) {
+                throw std::runtime_error("At most 100 courses per semester.");
+            }
+            for (const auto& c : req.courses) {
+                validateCourse(c.grade, c.credit);
+            }
+            resp.value = registry.withStudent(req.id, [&req](Student& st) {
+                SemesterBuilder sem = st.emplaceSemester();
+                sem.reserve(req.courses.size());
+                for (const auto& c : req.courses) {
+                    sem.addCourse(c.grade, c.credit);
+                }
+                sem.commit();
+                return st.calculateCGPA();
+            });
+            break;
+        }
+        default:
+            resp.status = static_cast<uint8_t>(WireStatus::BadRequest);
+            break;
+        }
+    } catch (const std::out_of_range&) {
+        resp.status = static_cast<uint8_t>(WireStatus::UnknownStudent);
+    } catch (const std::invalid_argument&) {
+        resp.status = static_cast<uint8_t>(WireStatus::BadRequest);
+    } catch (const std::runtime_error&) {
+        resp.status = static_cast<uint8_t>(WireStatus::InvalidData);
+    }
+    return resp;
+}
+#ifdef CGPA_HAVE_UNIX_SOCKETS
+/*
+ * Function: serveUnixClient
+ * Reads whatever the client sends, answers every complete request in the buffer, and writes all those
+ * answers back in one go – pipelined clients get one write per read, not one per request.
+ */
+void serveUnixClient(int fd, StudentRegistry& registry) {
+    std::vector<char> inbox;
+    std::vector<char> outbox;
+    char chunk[64 * 1024];
+    WireRequest req;
+    while (true) {
+        const ssize_t got = ::read(fd, chunk, sizeof(chunk));
+        if (got <= 0) {
+            break;
+        }
+        inbox.insert(inbox.end(), chunk, chunk + got);
+        size_t offset = 0, consumed = 0;
+        outbox.clear();
+        while (decodeWireRequest(inbox.data() + offset, inbox.size() - offset, consumed, req)) {
+            offset += consumed;
+            const WireResponse resp = handleWireRequest(registry, req);
+            const char* bytes = reinterpret_cast<const char*>(&resp);
+            outbox.insert(outbox.end(), bytes, bytes + sizeof(resp));
+        }
+        inbox.erase(inbox.begin(), inbox.begin() + static_cast<std::ptrdiff_t>(offset));
+        size_t sent = 0;
+        while (sent < outbox.size()) {
+            const ssize_t n = ::send(fd, outbox.data() + sent, outbox.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                ::close(fd);
+                return;
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+    ::close(fd);
+}
+/*
+ * Function: runUnixSocketServer
+ * Server mode: keeps the registry in memory and answers requests on a Unix domain socket until killed,
+ * so there's no process start-up or file load per query. Each client gets its own thread.
+ * Throws if the socket can't be set up; an existing file at the path gets replaced.
+ */
+void runUnixSocketServer(const std::string& path, StudentRegistry& registry) {
+    sockaddr_un addr{};
+    if (path.size() >= sizeof(addr.sun_path)) {
+        throw std::invalid_argument("Socket path is too long.");
+    }
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listener < 0) {
+        throw std::runtime_error("Failed to create socket.");
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, path.c_str(), path.size() + 1);
+    ::unlink(path.c_str());
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listener, 128) < 0) {
+        ::close(listener);
+        throw std::runtime_error("Failed to bind socket at " + path + ".");
+    }
+    std::cout << "Serving on " << path << std::endl;
+    while (true) {
+        const int client = ::accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            continue;
+        }
+        std::thread(serveUnixClient, client, std::ref(registry)).detach();
+    }
+}
+#endif
+/*
+ * Function: handleWireBatch
+ * Answers a whole batch of requests (possibly from many connections) through the compute pool.
+ * Reads can run in any order, but an AddSemester has to land after the requests before it and before the ones
+ * after it, so the batch gets cut at every write: each run of reads fans out over parallelFor, writes run inline.
+ * Responses come back in the same order as the requests.
+ */
+std::vector<WireResponse> handleWireBatch(StudentRegistry& registry, const std::vector<WireRequest>& batch) {
+    std::vector<WireResponse> responses(batch.size());
+    size_t runStart = 0;
+    auto flushReads = [&](size_t runEnd) {
+        parallelFor(runEnd - runStart, [&](size_t begin, size_t end) {
+            for (size_t i = runStart + begin; i < runStart + end; ++i) {
+                responses[i] = handleWireRequest(registry, batch[i]);
+            }
+        });
+    };
+    for (size_t i = 0; i < batch.size(); ++i) {
+        if (static_cast<WireOp>(batch[i].header.op) == WireOp::AddSemester) {
+            flushReads(i);
+            responses[i] = handleWireRequest(registry, batch[i]);
+            runStart = i + 1;
+        }
+    }
+    flushReads(batch.size());
+    return responses;
+}
+#ifdef CGPA_HAVE_EPOLL
+/*
+ * Function: runEpollServer
+ * Event-driven TCP front-end on 127.0.0.1:port for lots of concurrent clients, using the same wire protocol as
+ * the Unix socket server. One thread runs the epoll loop with non-blocking sockets; every wake-up it reads
+ * whatever every ready connection has, decodes all complete (pipelined) requests into one batch, hands the batch
+ * to handleWireBatch, and queues each connection's answers. Writes that don't fit in the socket buffer wait for
+ * EPOLLOUT instead of blocking the loop. Runs until killed; throws if the listener can't be set up.
+ * Backpressure: a connection gets at most readBudget bytes read per wake-up (the rest waits in the kernel for
+ * the next round, so one busy client can't swell everybody's batch), and once more than outboxCap bytes of its
+ * answers are still unsent we stop reading from it altogether until it catches up. A client that pipelines
+ * without ever reading just ends up stalled on a full socket instead of growing our memory.
+ */
+void runEpollServer(uint16_t port, StudentRegistry& registry) {
+    struct Connection {
+        int fd;
+        std::vector<char> inbox;
+        std::vector<char> outbox;
+        size_t outboxSent = 0;
+        uint32_t interest = EPOLLIN;  // What epoll is currently watching this fd for.
+    };
+    const size_t readBudget = 256 * 1024;
+    const size_t outboxCap = 1024 * 1024;
+    const int listener = ::socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+    if (listener < 0) {
+        throw std::runtime_error("Failed to create socket.");
+    }
+    const int on = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (::bind(listener, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listener, 1024) < 0) {
+        ::close(listener);
+        throw std::runtime_error("Failed to listen on port " + std::to_string(port) + ".");
+    }
+    const int epfd = ::epoll_create1(0);
+    if (epfd < 0) {
+        ::close(listener);
+        throw std::runtime_error("Failed to create epoll instance.");
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = listener;
+    ::epoll_ctl(epfd, EPOLL_CTL_ADD, listener, &ev);
+    std::cout << "Serving on 127.0.0.1:" << port << std::endl;
+
+    std::unordered_map<int, Connection> connections;
+    std::vector<epoll_event> events(1024);
+    std::vector<WireRequest> batch;
+    std::vector<int> owners;  // Which connection each request in the batch came from.
+    char chunk[64 * 1024];
+    auto closeConnection = [&](int fd) {
+        ::epoll_ctl(epfd, EPOLL_CTL_DEL, fd, nullptr);
+        ::close(fd);
+        connections.erase(fd);
+    };
+    // Reads only while the unsent backlog is under the cap; watches for writability only while there is one.
+    auto updateInterest = [&](Connection& conn) {
+        const size_t unsent = conn.outbox.size() - conn.outboxSent;
+        const uint32_t want = (unsent < outboxCap ? static_cast<uint32_t>(EPOLLIN) : 0u) |
+                              (unsent > 0 ? static_cast<uint32_t>(EPOLLOUT) : 0u);
+        if (want != conn.interest) {
+            epoll_event mod{};
+            mod.events = want;
+            mod.data.fd = conn.fd;
+            ::epoll_ctl(epfd, EPOLL_CTL_MOD, conn.fd, &mod);
+            conn.interest = want;
+        }
+    };
+    // Pushes out as much of the outbox as the socket takes, then brings the epoll interest up to date.
+    auto flush = [&](Connection& conn) {
+        while (conn.outboxSent < conn.outbox.size()) {
+            const ssize_t n = ::send(conn.fd, conn.outbox.data() + conn.outboxSent,
+                                     conn.outbox.size() - conn.outboxSent, MSG_NOSIGNAL);
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            if (n <= 0) {
+                return false;
+            }
+            conn.outboxSent += static_cast<size_t>(n);
+        }
+        if (conn.outboxSent == conn.outbox.size()) {
+            conn.outbox.clear();
+            conn.outboxSent = 0;
+        }
+        updateInterest(conn);
+        return true;
+    };
+    while (true) {
+        const int ready = ::epoll_wait(epfd, events.data(), static_cast<int>(events.size()), -1);
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            throw std::runtime_error("epoll_wait failed.");
+        }
+        batch.clear();
+        owners.clear();
+        std::vector<int> broken;
+        for (int e = 0; e < ready; ++e) {
+            const int fd = events[e].data.fd;
+            if (fd == listener) {
+                int client;
+                while ((client = ::accept4(listener, nullptr, nullptr, SOCK_NONBLOCK)) >= 0) {
+                    ::setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+                    epoll_event cev{};
+                    cev.events = EPOLLIN;
+                    cev.data.fd = client;
+                    ::epoll_ctl(epfd, EPOLL_CTL_ADD, client, &cev);
+                    connections[client].fd = client;
+                }
+                continue;
+            }
+            auto it = connections.find(fd);
+            if (it == connections.end()) {
+                continue;
+            }
+            Connection& conn = it->second;
+            if (events[e].events & EPOLLOUT) {
+                if (!flush(conn)) {
+                    broken.push_back(fd);
+                    continue;
+                }
+            }
+            if (!(events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR))) {
+                continue;
+            }
+            if (!(conn.interest & EPOLLIN)) {
+                // Paused for backpressure – only a hangup or error gets through, and those end the connection.
+                broken.push_back(fd);
+                continue;
+            }
+            bool closed = false;
+            size_t readThisRound = 0;
+            while (readThisRound < readBudget) {
+                const ssize_t got = ::read(fd, chunk, std::min(sizeof(chunk), readBudget - readThisRound));
+                if (got > 0) {
+                    conn.inbox.insert(conn.inbox.end(), chunk, chunk + got);
+                    readThisRound += static_cast<size_t>(got);
+                    continue;
+                }
+                closed = got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+                break;
+            }
+            size_t offset = 0, consumed = 0;
+            WireRequest req;
+            while (decodeWireRequest(conn.inbox.data() + offset, conn.inbox.size() - offset, consumed, req)) {
+                offset += consumed;
+                batch.push_back(std::move(req));
+                owners.push_back(fd);
+            }
+            conn.inbox.erase(conn.inbox.begin(), conn.inbox.begin() + static_cast<std::ptrdiff_t>(offset));
+            if (closed) {
+                broken.push_back(fd);
+            }
+        }
+        const std::vector<WireResponse> responses = handleWireBatch(registry, batch);
+        for (size_t i = 0; i < responses.size(); ++i) {
+            auto it = connections.find(owners[i]);
+            const char* bytes = reinterpret_cast<const char*>(&responses[i]);
+            it->second.outbox.insert(it->second.outbox.end(), bytes, bytes + sizeof(WireResponse));
+        }
+        for (auto& entry : connections) {
+            if (!entry.second.outbox.empty() && !flush(entry.second)) {
+                broken.push_back(entry.first);
+            }
+        }
+        std::sort(broken.begin(), broken.end());
+        broken.erase(std::unique(broken.begin(), broken.end()), broken.end());
+        for (int fd : broken) {
+            closeConnection(fd);
+        }
+    }
+}
+/*
+ * Function: runLoadGenerator
+ * Bundled load client for the epoll server. Opens `connections` loopback connections (one thread each), gives each
+ * its own student, then fires `requests` CGPA queries per connection, keeping `depth` of them in flight at a time.
+ * Prints throughput when everyone's done. Returns false if any connection failed or got a non-Ok answer.
+ */
+bool runLoadGenerator(uint16_t port, size_t connections, size_t requests, size_t depth) {
+    depth = std::max<size_t>(1, depth);
+    std::atomic<bool> failed{false};
+    auto sendAll = [](int fd, const std::vector<char>& bytes) {
+        size_t sent = 0;
+        while (sent < bytes.size()) {
+            const ssize_t n = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0) {
+                return false;
+            }
+            sent += static_cast<size_t>(n);
+        }
+        return true;
+    };
+    auto recvAll = [](int fd, char* out, size_t size) {
+        size_t got = 0;
+        while (got < size) {
+            const ssize_t n = ::read(fd, out + got, size - got);
+            if (n <= 0) {
+                return false;
+            }
+            got += static_cast<size_t>(n);
+        }
+        return true;
+    };
+    auto encode = [](std::vector<char>& out, WireOp op, const std::string& id, const std::vector<Course>& courses) {
+        WireRequestHeader h{static_cast<uint8_t>(op), static_cast<uint8_t>(id.size()),
+                            static_cast<uint16_t>(courses.size()), 0};
+        const char* hb = reinterpret_cast<const char*>(&h);
+        out.insert(out.end(), hb, hb + sizeof(h));
+        out.insert(out.end(), id.begin(), id.end());
+        for (const auto& c : courses) {
+            const double pair[2] = {c.grade, c.credit};
+            const char* pb = reinterpret_cast<const char*>(pair);
+            out.insert(out.end(), pb, pb + sizeof(pair));
+        }
+    };
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> clients;
+    for (size_t c = 0; c < connections; ++c) {
+        clients.emplace_back([&, c]() {
+            const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+            sockaddr_in addr{};
+            addr.sin_family = AF_INET;
+            addr.sin_port = htons(port);
+            addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+            if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), sizeof(addr)) < 0) {
+                failed = true;
+                if (fd >= 0) {
+                    ::close(fd);
+                }
+                return;
+            }
+            const int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            const std::string id = "loadgen-" + std::to_string(c);
+            std::vector<char> out;
+            encode(out, WireOp::AddSemester, id, {Course(8.0, 4.0), Course(9.0, 3.0)});
+            WireResponse resp{};
+            bool ok = sendAll(fd, out) && recvAll(fd, reinterpret_cast<char*>(&resp), sizeof(resp)) && resp.status == 0;
+            std::vector<char> query;
+            encode(query, WireOp::Cgpa, id, {});
+            std::vector<WireResponse> answers(depth);
+            for (size_t done = 0; ok && done < requests;) {
+                const size_t burst = std::min(depth, requests - done);
+                out.clear();
+                for (size_t i = 0; i < burst; ++i) {
+                    out.insert(out.end(), query.begin(), query.end());
+                }
+                ok = sendAll(fd, out) &&
+                     recvAll(fd, reinterpret_cast<char*>(answers.data()), burst * sizeof(WireResponse));
+                for (size_t i = 0; ok && i < burst; ++i) {
+                    ok = answers[i].status == 0;
+                }
+                done += burst;
+            }
+            if (!ok) {
+                failed = true;
+            }
+            ::close(fd);
+        });
+    }
+    for (auto& t : clients) {
+        t.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const double total = static_cast<double>(connections * requests);
+    std::cout << std::fixed << std::setprecision(0) << total << " requests in " << std::setprecision(3) << seconds
+              << " s (" << std::setprecision(0) << total / seconds << " req/s)" << std::endl;
+    return !failed;
+}
+#endif
+/*
+ * Function: runSelfTest
+ * "--selftest" mode: runs the cohort, concurrency and async APIs against brute-force answers on a synthetic
+ * cohort and prints one "pass <check>" / "FAIL <check>" line each, then a summary. Returns the number of failures.
+ * Covers the things the menu never calls: CohortRanking (including update() against a fresh rankAll),
+ * topKStudents, studentsAtOrAbove, cgpaStatistics, aggregateBy, CohortIngestor with several producer threads,
+ * VersionedStudent with a reader running alongside the writer, and (in a C++20 build) the *Async functions.
+ */
+size_t runSelfTest(std::ostream& out) {
+    size_t passed = 0, failed = 0;
+    auto check = [&](bool ok, const std::string& what) {
+        out << (ok ? "pass " : "FAIL ") << what << '\n';
+        ++(ok ? passed : failed);
+    };
+    auto addSemester = [](Student& st, const std::string& term, std::initializer_list<Course> courses) {
+        SemesterBuilder sem = st.emplaceSemester();
+        for (const auto& c : courses) {
+            sem.addCourse(c.grade, c.credit);
+        }
+        sem.commit(term);
+    };
+    // Big enough that parallelFor really splits the work. Grades repeat, so there are plenty of ties to rank.
+    const size_t n = 2000;
+    std::vector<Student> cohort(n);
+    for (size_t i = 0; i < n; ++i) {
+        cohort[i].setDepartment(i % 3 == 0 ? "CSE" : i % 3 == 1 ? "ECE" : "ME");
+        cohort[i].setBatch(std::to_string(2020 + i % 4));
+        for (size_t t = 0; t < 1 + i % 3; ++t) {
+            addSemester(cohort[i], "T" + std::to_string(t),
+                        {Course(static_cast<double>((i * 7 + t) % 11), 3.0), Course(static_cast<double>(i % 5 + 5), 2.0)});
+        }
+    }
+    // One student whose CGPA comes out NaN (inf credits over inf points), which has to rank last everywhere.
+    const size_t nanStudent = n;
+    cohort.emplace_back();
+    addSemester(cohort[nanStudent], "T0", {Course(5.0, 1e308), Course(5.0, 1e308)});
+    const size_t total = cohort.size();
+
+    // CohortRanking: competition ranks and percentiles by brute force, then incremental vs full re-rank.
+    CohortRanking ranking;
+    ranking.rankAll(cohort);
+    bool ranksOk = ranking.getOrder().size() == total;
+    for (size_t i = 0; i < total && ranksOk; i += 37) {
+        size_t higher = 0, lower = 0;
+        for (size_t j = 0; j < total; ++j) {
+            higher += ranking.cgpaOf(j) > ranking.cgpaOf(i);
+            lower += ranking.cgpaOf(j) < ranking.cgpaOf(i);
+        }
+        ranksOk = ranking.rankOf(i) == higher + 1 &&
+                  std::abs(ranking.percentileOf(i) - 100.0 * static_cast<double>(lower) / total) < 1e-9;
+    }
+    check(ranksOk, "ranking rankAll matches brute force");
+    check(ranking.getOrder().back() == nanStudent, "ranking puts NaN last");
+    std::vector<size_t> changed;
+    for (size_t i = 0; i < n; i += 97) {
+        addSemester(cohort[i], "T9", {Course(static_cast<double>(i % 11), 4.0)});
+        changed.push_back(i);
+    }
+    changed.push_back(changed.front());  // Duplicates are allowed.
+    ranking.update(cohort, changed);
+    CohortRanking fresh;
+    fresh.rankAll(cohort);
+    bool sameAsFresh = ranking.getOrder() == fresh.getOrder();
+    for (size_t i = 0; i < total && sameAsFresh; ++i) {
+        sameAsFresh = ranking.rankOf(i) == fresh.rankOf(i) && ranking.percentileOf(i) == fresh.percentileOf(i);
+    }
+    check(sameAsFresh, "ranking update matches full rankAll");
+
+    // topKStudents and studentsAtOrAbove against a full sort.
+    std::vector<CohortEntry> everyone;
+    for (size_t i = 0; i < total; ++i) {
+        everyone.push_back(CohortEntry{i, cohort[i].calculateCGPA()});
+    }
+    std::sort(everyone.begin(), everyone.end(), entryBefore);
+    auto sameStudents = [](const std::vector<CohortEntry>& a, const std::vector<CohortEntry>& b, size_t count) {
+        if (a.size() != count || b.size() < count) {
+            return false;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            if (a[i].student != b[i].student) {
+                return false;
+            }
+        }
+        return true;
+    };
+    check(sameStudents(topKStudents(cohort, 25), everyone, 25), "topKStudents(25) matches full sort");
+    const std::vector<CohortEntry> all = topKStudents(cohort, total + 10);
+    check(sameStudents(all, everyone, total) && all.back().student == nanStudent, "topKStudents(all) puts NaN last");
+    const double cutoff = 8.0;
+    const std::vector<CohortEntry> honours = studentsAtOrAbove(cohort, cutoff);
+    const size_t expectedHonours = static_cast<size_t>(
+        std::count_if(everyone.begin(), everyone.end(), [cutoff](const CohortEntry& e) { return e.cgpa >= cutoff; }));
+    check(sameStudents(honours, everyone, expectedHonours), "studentsAtOrAbove(8) matches full sort");
+
+    // cgpaStatistics: exact count/min/max/mean, quantiles within one 0.01 bin, NaN counted as skipped.
+    const CgpaHistogram stats = cgpaStatistics(cohort);
+    std::vector<double> finite;
+    double sum = 0.0;
+    for (const auto& e : everyone) {
+        if (std::isfinite(e.cgpa)) {
+            finite.push_back(e.cgpa);
+            sum += e.cgpa;
+        }
+    }
+    std::sort(finite.begin(), finite.end());
+    const double exactMedian = finite[(finite.size() + 1) / 2 - 1];
+    check(stats.count() == finite.size() && stats.skipped() == 1, "cgpaStatistics counts and skips NaN");
+    check(stats.min() == finite.front() && stats.max() == finite.back() &&
+              std::abs(stats.mean() - sum / static_cast<double>(finite.size())) < 1e-9,
+          "cgpaStatistics min/max/mean");
+    check(std::abs(stats.quantile(0.5) - exactMedian) <= 0.01 + 1e-9 && stats.quantile(0.0) == finite.front() &&
+              stats.quantile(1.0) == finite.back(),
+          "cgpaStatistics quantiles");
+
+    // aggregateBy: per-department totals and the semester count for Term.
+    const auto byDept = aggregateBy(cohort, GroupBy::Department);
+    std::unordered_map<std::string, GroupTotals> expectedDept;
+    size_t semesterTotal = 0;
+    for (size_t i = 0; i < n; ++i) {
+        GroupTotals& g = expectedDept[cohort[i].getDepartment()];
+        g.credits += cohort[i].totalCredits();
+        g.points += cohort[i].totalPoints();
+        ++g.members;
+        semesterTotal += cohort[i].getSemesters().size();
+    }
+    bool deptOk = byDept.size() == 4 && byDept.count("") == 1;  // The NaN student has no department.
+    for (const auto& entry : expectedDept) {
+        auto it = byDept.find(entry.first);
+        deptOk = deptOk && it != byDept.end() && it->second.members == entry.second.members &&
+                 std::abs(it->second.gpa() - entry.second.gpa()) < 1e-9;
+    }
+    check(deptOk, "aggregateBy department");
+    size_t termMembers = 0;
+    for (const auto& entry : aggregateBy(cohort, GroupBy::Term)) {
+        termMembers += entry.second.members;
+    }
+    check(termMembers == semesterTotal + 1, "aggregateBy term counts every semester");
+
+    // CohortIngestor: several producers at once, each owning a slice of students, with the applier draining
+    // while they run. Every student ends up with two semesters: one course by course, one shipped whole.
+    {
+        const size_t students = 64, producers = 4, coursesEach = 5;
+        std::vector<Student> target(students);
+        CohortIngestor ingestor(target);
+        std::atomic<size_t> producing{producers};
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < producers; ++p) {
+            threads.emplace_back([&, p]() {
+                for (size_t s = p; s < students; s += producers) {
+                    for (size_t c = 0; c < coursesEach; ++c) {
+                        ingestor.submitCourse(s, static_cast<double>((s + c) % 11), 1.0 + c);
+                    }
+                    ingestor.closeSemester(s);
+                    Semester whole;
+                    whole.addCourse(static_cast<double>(s % 11), 4.0);
+                    ingestor.submitSemester(s, std::move(whole));
+                }
+                --producing;
+            });
+        }
+        size_t applied = 0;
+        while (producing.load() > 0) {
+            applied += ingestor.applyPending();
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        applied += ingestor.applyPending();
+        bool ingestOk = applied == students * (coursesEach + 2) && ingestor.openSemesterCount() == 0;
+        for (size_t s = 0; s < students && ingestOk; ++s) {
+            Student expected;
+            SemesterBuilder sem = expected.emplaceSemester();
+            for (size_t c = 0; c < coursesEach; ++c) {
+                sem.addCourse(static_cast<double>((s + c) % 11), 1.0 + c);
+            }
+            sem.commit();
+            addSemester(expected, "", {Course(static_cast<double>(s % 11), 4.0)});
+            ingestOk = target[s].getSemesters().size() == 2 &&
+                       target[s].calculateCGPA() == expected.calculateCGPA();
+        }
+        check(ingestOk, "CohortIngestor multi-producer ingestion");
+        bool rejected = false;
+        try {
+            ingestor.submitCourse(0, 11.0, 3.0);
+        } catch (const InvalidGradeException&) {
+            rejected = true;
+        }
+        try {
+            ingestor.closeSemester(students);
+            rejected = false;
+        } catch (const std::out_of_range&) {
+        }
+        check(rejected && ingestor.applyPending() == 0, "CohortIngestor rejects bad submits");
+    }
+
+    // VersionedStudent: a reader keeps taking snapshots while the writer publishes; every snapshot has to be
+    // a whole version (never shrinking, CGPA stable while held), and a throwing update publishes nothing.
+    {
+        VersionedStudent versioned;
+        const size_t updates = 300;
+        std::atomic<bool> done{false};
+        std::atomic<bool> readerOk{true};
+        std::thread reader([&]() {
+            size_t lastSeen = 0;
+            while (!done.load()) {
+                const auto snap = versioned.snapshot();
+                const size_t count = snap->getSemesters().size();
+                const double cgpa = snap->calculateCGPA();
+                if (count < lastSeen || snap->calculateCGPA() != cgpa) {
+                    readerOk = false;
+                }
+                lastSeen = count;
+            }
+        });
+        for (size_t u = 0; u < updates; ++u) {
+            Semester sem;
+            sem.addCourse(static_cast<double>(u % 11), 3.0);
+            versioned.addSemester(std::move(sem));
+        }
+        done = true;
+        reader.join();
+        check(readerOk.load() && versioned.version() == updates &&
+                  versioned.snapshot()->getSemesters().size() == updates,
+              "VersionedStudent snapshots under concurrent updates");
+        try {
+            versioned.update([](Student& st) {
+                st.addSemester(Semester());
+                throw std::runtime_error("abandoned");
+            });
+        } catch (const std::runtime_error&) {
+        }
+        check(versioned.version() == updates && versioned.snapshot()->getSemesters().size() == updates,
+              "VersionedStudent keeps old version when update throws");
+    }
+
+#ifdef CGPA_HAVE_COROUTINES
+    // Async API: CGPAs through the pool, then a save/load round trip and a failed load.
+    {
+        std::vector<Task<double>> tasks;
+        for (size_t i = 0; i < 50; ++i) {
+            tasks.push_back(calculateCGPAAsync(cohort[i]));
+        }
+        const std::vector<double> cgpas = runAll(tasks);
+        bool asyncOk = cgpas.size() == 50;
+        for (size_t i = 0; i < cgpas.size() && asyncOk; ++i) {
+            asyncOk = cgpas[i] == cohort[i].calculateCGPA();
+        }
+        check(asyncOk, "calculateCGPAAsync matches calculateCGPA");
+        const std::string scratch = "cgpa_selftest.tmp";
+        Student reloaded;
+        bool roundTrip = false;
+        try {
+            saveToFileAsync(cohort[5], scratch).get();
+            loadFromFileAsync(reloaded, scratch).get();
+            roundTrip = reloaded.getSemesters().size() == cohort[5].getSemesters().size() &&
+                        reloaded.getDepartment() == cohort[5].getDepartment() &&
+                        reloaded.calculateCGPA() == cohort[5].calculateCGPA();
+        } catch (const std::exception&) {
+        }
+        std::remove(scratch.c_str());
+        check(roundTrip, "saveToFileAsync/loadFromFileAsync round trip");
+        bool failedCleanly = false;
+        try {
+            loadFromFileAsync(reloaded, scratch).get();
+        } catch (const std::runtime_error&) {
+            failedCleanly = reloaded.getSemesters().size() == cohort[5].getSemesters().size();
+        }
+        check(failedCleanly, "loadFromFileAsync on a missing file throws and leaves the student alone");
     }
+#endif
+    out << "selftest passed=" << passed << " failed=" << failed << std::endl;
+    return failed;
+}
+/*
+ * Function: runBenchmark
+ * Benchmark mode: builds a synthetic cohort and times the core operations – building it course by course,
+ * computing every CGPA, and a save/load round trip of one big student through a scratch file. Prints one
+ * key=value line per operation, plus allocation counts when built with -DCGPA_TRACK_ALLOCS.
+ */
+void runBenchmark(std::ostream& out, size_t students, size_t semesters, size_t courses) {
+    using Clock = std::chrono::steady_clock;
+    auto millis = [](Clock::time_point a, Clock::time_point b) {
+        return std::chrono::duration<double, std::milli>(b - a).count();
+    };
+    auto timed = [&](const std::string& label, auto&& op) {
+        const AllocStats before = AllocationTracker::totals();
+        const auto start = Clock::now();
+        op();
+        const auto end = Clock::now();
+        const AllocStats after = AllocationTracker::totals();
+        out << "op=" << label << " ms=" << std::fixed << std::setprecision(3) << millis(start, end) << '\n';
+        reportAllocations(out, label, before, after);
+    };
+    std::vector<Student> cohort(students);
+    timed("build", [&]() {
+        for (size_t s = 0; s < students; ++s) {
+            cohort[s].reserve(semesters, semesters * courses);
+            for (size_t t = 0; t < semesters; ++t) {
+                SemesterBuilder sem = cohort[s].emplaceSemester();
+                for (size_t c = 0; c < courses; ++c) {
+                    sem.addCourse(static_cast<double>((s + t + c) % 11), static_cast<double>(1 + c % 4));
+                }
+                sem.commit();
+            }
+        }
+    });
+    double checksum = 0.0;
+    timed("cgpa", [&]() {
+        CGPA_ALLOC_SCOPE(AllocTag::Compute);
+        for (const auto& st : cohort) {
+            checksum += st.calculateCGPA();
+        }
+    });
+    // One student holding the whole cohort's semesters, so the file I/O has something to chew on.
+    Student big;
+    big.reserve(students * semesters, students * semesters * courses);
+    for (const auto& st : cohort) {
+        for (const auto& sem : st.getSemesters()) {
+            SemesterBuilder copy = big.emplaceSemester();
+            for (const auto& c : sem.getCourses()) {
+                copy.addCourse(c.grade, c.credit);
+            }
+            copy.commit();
+        }
+    }
+    const std::string scratch = "cgpa_bench.tmp";
+    timed("save", [&]() {
+        std::ofstream file(scratch);
+        big.writeRecords(file);
+    });
+    Student reloaded;
+    timed("load", [&]() {
+        std::ifstream file(scratch);
+        reloaded.readRecords(file);
+    });
+    std::remove(scratch.c_str());
+    out << "checksum=" << std::setprecision(6) << checksum << " reloaded_semesters=" << reloaded.getSemesters().size()
+        << '\n';
+    reportAllocationTags(out);
+    out.flush();
 }
 /*
  * Function: main
@@ -222,7 +4218,164 @@ T getValidatedInput(const std::string& prompt, T minVal, T maxVal) {
  * Used a lambda for the menu to avoid repeating the print code. Input validation keeps things from breaking on dumb entries.
  * Key points: Takes input for number of courses, grade and credit for each, computes GPA/CGPA, and displays results.
  */
-int main() {
+int main(int argc, char* argv[]) {
+    // "--metrics <file>" anywhere on the command line keeps a Prometheus textfile fresh (every 10 s) while a
+    // server mode runs. It's pulled out of argv first, so the mode checks below still see the mode in argv[1].
+    std::string metricsPath;
+    int kept = 1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::string(argv[i]) == "--metrics" && i + 1 < argc) {
+            metricsPath = argv[++i];
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+    argv[argc] = nullptr;
+    auto startServerMetrics = [&metricsPath]() {
+        if (!metricsPath.empty()) {
+            startMetricsDumper(metricsPath, 10);
+        }
+    };
+    // "--serve <socket path>" skips the menu and runs the resident server instead. Whatever is in
+    // cgpa_data.txt gets preloaded under the student ID "default".
+    if (argc >= 3 && std::string(argv[1]) == "--serve") {
+#ifdef CGPA_HAVE_UNIX_SOCKETS
+        StudentRegistry registry;
+        registry.withStudent("default", [](Student& st) { st.loadFromFile(); });
+        startServerMetrics();
+        try {
+            runUnixSocketServer(argv[2], registry);
+        } catch (const std::exception& e) {
+            std::cerr << "Server error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+#else
+        std::cerr << "Server mode needs Unix domain sockets, which this platform doesn't have." << std::endl;
+        return 1;
+#endif
+    }
+    // "--serve-tcp <port>" runs the epoll front-end on loopback; "--loadgen <port> <connections> <requests>
+    // <pipeline depth>" hammers it for testing.
+    if (argc >= 3 && (std::string(argv[1]) == "--serve-tcp" || std::string(argv[1]) == "--loadgen")) {
+#ifdef CGPA_HAVE_EPOLL
+        try {
+            const auto port = static_cast<uint16_t>(std::stoul(argv[2]));
+            if (std::string(argv[1]) == "--loadgen") {
+                const size_t connections = argc > 3 ? std::stoul(argv[3]) : 16;
+                const size_t requests = argc > 4 ? std::stoul(argv[4]) : 10000;
+                const size_t depth = argc > 5 ? std::stoul(argv[5]) : 32;
+                return runLoadGenerator(port, connections, requests, depth) ? 0 : 1;
+            }
+            StudentRegistry registry;
+            registry.withStudent("default", [](Student& st) { st.loadFromFile(); });
+            startServerMetrics();
+            runEpollServer(port, registry);
+        } catch (const std::exception& e) {
+            std::cerr << "Server error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+#else
+        std::cerr << "The TCP front-end needs epoll, which this platform doesn't have." << std::endl;
+        return 1;
+#endif
+    }
+    // "--import-csv <file>" pulls an SIS export (student_id,term,course,grade,credits) into a registry and prints
+    // "student <id> cgpa <x>" per student, sorted by ID. Add "--json" or "--ndjson" to get every student's
+    // semester GPAs and CGPA as JSON instead, or "--columnar <out>" to write them to a columnar file (see
+    // ColumnarCohort). Skipped rows and a summary go to stderr.
+    if (argc >= 3 && std::string(argv[1]) == "--import-csv") {
+        StudentRegistry registry;
+        CsvImportResult imported;
+        try {
+            imported = importCsvFile(argv[2], registry);
+        } catch (const std::exception& e) {
+            std::cerr << "Error importing CSV: " << e.what() << std::endl;
+            return 1;
+        }
+        const std::string format = argc > 3 ? argv[3] : "";
+        if (format == "--columnar" && argc > 4) {
+            try {
+                writeCohortColumnarFile(argv[4], registry);
+            } catch (const std::exception& e) {
+                std::cerr << "Error exporting: " << e.what() << std::endl;
+                return 1;
+            }
+        } else if (format == "--json") {
+            writeCohortJson(std::cout, registry);
+        } else if (format == "--ndjson") {
+            writeCohortNdjson(std::cout, registry);
+        } else {
+            std::vector<std::string> ids;
+            const std::vector<Student> cohort = registry.exportCohort(ids);
+            std::vector<size_t> order(ids.size());
+            for (size_t i = 0; i < order.size(); ++i) {
+                order[i] = i;
+            }
+            std::sort(order.begin(), order.end(), [&ids](size_t x, size_t y) { return ids[x] < ids[y]; });
+            std::cout << std::fixed << std::setprecision(4);
+            for (size_t i : order) {
+                std::cout << "student " << ids[i] << " cgpa " << cohort[i].calculateCGPA() << '\n';
+            }
+        }
+        std::cout.flush();
+        for (size_t line : imported.badLines) {
+            std::cerr << "Skipped line " << line << '\n';
+        }
+        std::cerr << "rows=" << imported.rows << " students=" << imported.students
+                  << " semesters=" << imported.semesters << " skipped=" << imported.badLines.size() << std::endl;
+        return 0;
+    }
+    // "--selftest" checks the cohort, concurrency and async APIs against brute-force answers (see runSelfTest).
+    if (argc >= 2 && std::string(argv[1]) == "--selftest") {
+        return runSelfTest(std::cout) == 0 ? 0 : 1;
+    }
+    // "--batch" reads saved-format data (course count, then grade/credit pairs) from stdin and prints one
+    // "semester <n> gpa <x>" line per semester and a final "cgpa <x>" line – no prompts, easy to script.
+    // "--batch --json" prints the same thing as one JSON object. Timing stats (when built in) go to stderr as
+    // key=value lines so they don't mix with the results.
+    if (argc >= 2 && std::string(argv[1]) == "--batch") {
+        Student batchStudent;
+        const AllocStats beforeLoad = AllocationTracker::totals();
+        try {
+            CGPA_TIME_SCOPE(Probe::LoadFromFile);
+            batchStudent.readRecords(stdinTokenizer());
+        } catch (const std::exception& e) {
+            std::cerr << "Error reading input: " << e.what() << std::endl;
+            return 1;
+        }
+        const AllocStats afterLoad = AllocationTracker::totals();
+        if (argc >= 3 && std::string(argv[2]) == "--json") {
+            writeStudentJson(std::cout, batchStudent);
+            std::cout.flush();
+        } else {
+            std::cout << std::fixed << std::setprecision(4);
+            const auto& sems = batchStudent.getSemesters();
+            for (size_t i = 0; i < sems.size(); ++i) {
+                std::cout << "semester " << i + 1 << " gpa " << sems[i].calculateGPA() << '\n';
+            }
+            std::cout << "cgpa " << batchStudent.calculateCGPA() << std::endl;
+        }
+        dumpInstrumentation(std::cerr, true);
+        reportAllocations(std::cerr, "load", beforeLoad, afterLoad);
+        reportAllocationTags(std::cerr);
+        return 0;
+    }
+    // "--bench [students] [semesters] [courses]" times the core operations on a synthetic cohort.
+    if (argc >= 2 && std::string(argv[1]) == "--bench") {
+        try {
+            const size_t students = argc > 2 ? std::stoul(argv[2]) : 10000;
+            const size_t semesters = argc > 3 ? std::stoul(argv[3]) : 8;
+            const size_t courses = argc > 4 ? std::stoul(argv[4]) : 6;
+            runBenchmark(std::cout, students, semesters, courses);
+        } catch (const std::exception& e) {
+            std::cerr << "Benchmark error: " << e.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
     Student student;
     int choice;
     // Lambda for showing the menu – keeps it tidy if the menu gets longer.
@@ -232,38 +4385,81 @@ int main() {
         std::cout << "2. Display Result" << std::endl;
         std::cout << "3. Save to File" << std::endl;
         std::cout << "4. Load from File" << std::endl;
-        std::cout << "5. Exit" << std::endl;
+        std::cout << "5. Target CGPA Planner" << std::endl;
+        std::cout << "6. Show Timing Stats" << std::endl;
+        std::cout << "7. Export Metrics" << std::endl;
+        std::cout << "8. Paste Semesters" << std::endl;
+        std::cout << "9. Exit" << std::endl;
         std::cout << "Enter choice: ";
     };
-    do {
-        displayMenu();
-        choice = getValidatedInput<int>("", 1, 5);  // Makes sure choice is between 1 and 5.
-        switch (choice) {
-        case 1: {
-            Semester sem;
-            int n = getValidatedInput<int>("Enter number of courses: ", 1, 100);  // Capped at 100 to be reasonable.
-            for (int i = 0; i < n; ++i) {
-                double grade = getValidatedInput<double>("Enter numeric grade (0–10): ", 0.0, 10.0);
-                double credit = getValidatedInput<double>("Enter credit hours (>0): ", 0.01, 100.0);  // Gotta be positive.
-                sem.addCourse(grade, credit);
+    // If stdin runs out mid-menu (a piped script that ended, Ctrl-D), getValidatedInput throws EndOfInputException
+    // and we just leave.
+    try {
+        do {
+            displayMenu();
+            choice = getValidatedInput<int>("", 1, 9);  // Makes sure choice is between 1 and 9.
+            switch (choice) {
+            case 1: {
+                // Courses get written straight into the student's storage; commit() closes the semester off.
+                SemesterBuilder sem = student.emplaceSemester();
+                int n = getValidatedInput<int>("Enter number of courses: ", 1,
+                                               static_cast<int>(maxCoursesPerSemester));
+                sem.reserve(static_cast<size_t>(n));
+                for (int i = 0; i < n; ++i) {
+                    double grade = getValidatedInput<double>("Enter numeric grade (0–10): ", minGrade, maxGrade);
+                    double credit = getValidatedInput<double>("Enter credit hours (>0): ", minCredit, maxCredit);
+                    validateCourse(grade, credit);  // The prompts already enforce it; this keeps the rule in one place.
+                    sem.addCourse(grade, credit);
+                }
+                sem.commit();
+                break;
             }
-            student.addSemester(std::move(sem));
-            break;
-        }
-        case 2:
-            student.displayAll();
-            break;
-        case 3:
-            student.saveToFile();
-            break;
-        case 4:
-            student.loadFromFile();
-            break;
-        case 5:
-            std::cout << "Exiting program." << std::endl;
-            break;
-        }
-    } while (choice != 5);
+            case 2:
+                student.displayAll();
+                break;
+            case 3:
+                student.saveToFile();
+                break;
+            case 4:
+                student.loadFromFile();
+                break;
+            case 5: {
+                double target = getValidatedInput<double>("Enter target CGPA (0–10): ", minGrade, maxGrade);
+                double planned = getValidatedInput<double>("Enter planned future credits (>0): ", 0.01, 1000.0);
+                double needed = student.requiredAverageGrade(target, planned);
+                std::cout << std::fixed << std::setprecision(2);
+                if (needed > 10.0) {
+                    std::cout << "Target not reachable – you'd need an average of " << needed << "." << std::endl;
+                } else {
+                    std::cout << "Required average grade: " << needed << std::endl;
+                }
+                break;
+            }
+            case 6:
+                dumpInstrumentation(std::cout, false);
+                break;
+            case 7:
+                if (writeMetricsFile("cgpa_metrics.prom")) {
+                    std::cout << "Metrics written to cgpa_metrics.prom." << std::endl;
+                } else {
+                    std::cerr << "Error writing metrics file." << std::endl;
+                }
+                break;
+            case 8: {
+                std::cout << "Paste one semester per line as grade:credit pairs (e.g. 8.5:4 7:3 9:2)." << std::endl;
+                std::cout << "Blank line to finish." << std::endl;
+                const size_t added = pasteSemesters(student, stdinTokenizer());
+                std::cout << added << (added == 1 ? " semester" : " semesters") << " added." << std::endl;
+                break;
+            }
+            case 9:
+                std::cout << "Exiting program." << std::endl;
+                break;
+            }
+        } while (choice != 9);
+    } catch (const EndOfInputException&) {
+        std::cout << "\nExiting program." << std::endl;
+    }
 return 0;
 }
 // End of code